@@ -0,0 +1,18 @@
+unsigned int x;
+
+void step(void)
+{
+  while(x < 0x0fffffff) {
+    x += 2;
+  }
+}
+
+int main(void) {
+  x = 0;
+
+  // both loops are the same once inlined
+  step();
+  step();
+
+  assert(!(x % 2));
+}
@@ -0,0 +1,20 @@
+int shared;
+int counter;
+
+void worker()
+{
+  counter=1;
+  if(shared)
+    counter=2;
+  counter++;
+  __CPROVER_assert(counter==2 || counter==3, "counter is local");
+  shared=1;
+}
+
+int main()
+{
+  counter=0;
+  __CPROVER_ASYNC_1: worker();
+  shared=0;
+  return 0;
+}
@@ -0,0 +1,19 @@
+int shared;
+int counter;
+
+void worker()
+{
+  counter=1;
+  if(shared)
+    counter=2;
+  counter++;
+  __CPROVER_assert(counter==2, "counter depends on shared");
+}
+
+int main()
+{
+  counter=0;
+  __CPROVER_ASYNC_1: worker();
+  shared=1;
+  return 0;
+}
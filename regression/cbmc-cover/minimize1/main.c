@@ -0,0 +1,20 @@
+int main()
+{
+  int input;
+
+  __CPROVER_input("input", input);
+
+  // Every test takes exactly one of the three paths, and each path has a
+  // branch that no other path takes. Whichever models the solver returns,
+  // the suite has three tests, and minimization has to keep all of them.
+
+  if(input<0)
+  {
+  }
+  else if(input==0)
+  {
+  }
+  else
+  {
+  }
+}
@@ -0,0 +1,24 @@
+#!/bin/bash
+
+cbmc=../../../src/cbmc/cbmc
+
+# --java-method-cache is given without a file name: the test is run twice
+# with a fresh cache file, such that the second run reuses the first's
+# methods
+if ! echo "$@" | grep -q -- "--java-method-cache" ; then
+  exec $cbmc "$@"
+fi
+
+cache=$(mktemp -d)
+trap 'rm -rf "$cache"' EXIT
+
+args=()
+for arg in "$@" ; do
+  args+=("$arg")
+  if [ "$arg" == "--java-method-cache" ] ; then
+    args+=("$cache/method-cache.gb")
+  fi
+done
+
+$cbmc "${args[@]}"
+$cbmc "${args[@]}"
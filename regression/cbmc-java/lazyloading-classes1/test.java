@@ -0,0 +1,32 @@
+// With lazy methods, classes are only read once they are needed:
+// test::unused is not reachable, hence C, which only B::g uses, is not.
+
+public class test
+{
+  public static void main()
+  {
+    A.f();
+  }
+
+  public static void unused()
+  {
+    B.g();
+  }
+}
+
+class A
+{
+  public static void f() {}
+}
+
+class B
+{
+  public static void g()
+  {
+    C c=new C();
+  }
+}
+
+class C
+{
+}
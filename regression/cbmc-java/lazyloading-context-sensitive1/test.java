@@ -0,0 +1,23 @@
+// B is instantiated, but not at the call to f, whose receiver can only
+// be the A allocated just before it. Hence A::f is reachable and B::f
+// is not, unlike with context-insensitive lazy loading.
+
+public class test
+{
+  public static void main()
+  {
+    B b = new B();
+    A a = new A();
+    a.f();
+  }
+}
+
+class A
+{
+  public void f() {}
+}
+
+class B extends A
+{
+  public void f() {}
+}
@@ -0,0 +1,26 @@
+class A
+{
+  B b;
+}
+
+class B
+{
+  A a;
+}
+
+public class test
+{
+  public static void main(A x)
+  {
+    if(x!=null && x.b!=null && x.b.a!=null && x.b.a.b!=null &&
+       x.b.a.b.a!=null && x.b.a.b.a.b!=null)
+    {
+      // the nondet initialization of x stops at this depth
+      if(x.b.a.b.a.b.a!=null)
+        throw new AssertionError();
+
+      // but does reach the one before
+      throw new AssertionError();
+    }
+  }
+}
@@ -0,0 +1,22 @@
+int inc(int x)
+  __CPROVER_requires(x<100)
+  __CPROVER_ensures(__CPROVER_return_value==x+1)
+{
+  return x+1;
+}
+
+int twice(int x)
+  __CPROVER_requires(x<50)
+  __CPROVER_ensures(__CPROVER_return_value==x+2)
+{
+  return inc(inc(x));
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x<10);
+  int y=twice(x);
+  __CPROVER_assert(y==x+2, "twice");
+  return 0;
+}
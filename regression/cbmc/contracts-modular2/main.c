@@ -0,0 +1,15 @@
+int dec(int x)
+  __CPROVER_requires(x>0)
+  __CPROVER_ensures(__CPROVER_return_value>=0)
+{
+  return x-2;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x>0 && x<10);
+  int y=dec(x);
+  __CPROVER_assert(y>=0, "non-negative");
+  return 0;
+}
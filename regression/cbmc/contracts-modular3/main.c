@@ -0,0 +1,16 @@
+int limit=10;
+
+int clamp(int x)
+  __CPROVER_ensures(__CPROVER_return_value<=10)
+{
+  // holds only with the initial value of the global
+  return x<limit?x:limit;
+}
+
+int main()
+{
+  int x;
+  int y=clamp(x);
+  __CPROVER_assert(y<=10, "clamped");
+  return 0;
+}
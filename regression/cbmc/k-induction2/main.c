@@ -0,0 +1,11 @@
+int main()
+{
+  int i=0;
+
+  while(i<100)
+  {
+    i++;
+    // fails in the third iteration
+    __CPROVER_assert(i!=3, "property");
+  }
+}
@@ -0,0 +1,14 @@
+int a[2];
+
+int main()
+{
+  int i=0;
+
+  while(i<1000)
+  {
+    // the step case does not havoc array elements
+    a[0]=i;
+    i++;
+    __CPROVER_assert(i>0, "property");
+  }
+}
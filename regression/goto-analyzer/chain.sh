@@ -0,0 +1,37 @@
+#!/bin/bash
+
+goto_analyzer=../../../src/goto-analyzer/goto-analyzer
+
+# --result-cache is given without a file name: the test is run without
+# the cache, and then twice with a fresh cache file, such that the second
+# run reuses the first's results; all runs need to give the same results
+if ! echo "$@" | grep -q -- "--result-cache" ; then
+  exec $goto_analyzer "$@"
+fi
+
+cache=$(mktemp -d)
+trap 'rm -rf "$cache"' EXIT
+
+args=()
+uncached_args=()
+for arg in "$@" ; do
+  args+=("$arg")
+  if [ "$arg" == "--result-cache" ] ; then
+    args+=("$cache/result-cache.json")
+  else
+    uncached_args+=("$arg")
+  fi
+done
+
+results()
+{
+  grep -e '^\[' -e '^SUMMARY' "$1"
+}
+
+$goto_analyzer "${uncached_args[@]}" > $cache/uncached.out
+
+for run in 1 2 ; do
+  $goto_analyzer "${args[@]}" > $cache/cached.out || exit
+  cat $cache/cached.out
+  diff <(results $cache/uncached.out) <(results $cache/cached.out) || exit
+done
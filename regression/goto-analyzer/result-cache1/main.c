@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int increment(int x)
+{
+  return x+1;
+}
+
+int main()
+{
+  int x=1;
+  assert(x==1);
+
+  int y=increment(x);
+  assert(y>100);
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+void f(int x)
+{
+  assert(x>0);
+}
+
+int main()
+{
+  f(5);
+  return 0;
+}
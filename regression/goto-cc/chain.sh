@@ -0,0 +1,30 @@
+#!/bin/bash
+
+set -e
+
+src=../../../src
+goto_cc=$src/goto-cc/goto-cc
+goto_instrument=$src/goto-instrument/goto-instrument
+cbmc=$src/cbmc/cbmc
+
+name=${@:$#}
+name=${name%.c}
+
+args=${@:1:$#-1}
+
+# all sources of the test are compiled and linked together
+sources=$(ls *.c)
+
+$goto_cc -o $name-serial.gb $sources
+$goto_cc $args -o $name.gb $sources
+
+# the result must not depend on the options, e.g., on --jobs
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+for gb in $name-serial.gb $name.gb ; do
+  $goto_instrument --show-symbol-table $gb > $out/$gb.txt
+  $goto_instrument --show-goto-functions $gb >> $out/$gb.txt
+done
+diff -u $out/$name-serial.gb.txt $out/$name.gb.txt
+
+$cbmc $name.gb
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int twice(int x);
+extern int counter;
+
+int main()
+{
+  assert(twice(2)==4);
+  assert(counter==1);
+  return 0;
+}
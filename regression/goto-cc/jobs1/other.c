@@ -0,0 +1,7 @@
+int counter;
+
+int twice(int x)
+{
+  counter++;
+  return 2*x;
+}
@@ -0,0 +1,25 @@
+typedef void(*void_fp)(void);
+
+void f(void) { }
+void g(void) { }
+void h(void) { }
+
+// take the address of h such that the type-based fallback would
+// consider it
+const void_fp fp_all[] = {h};
+
+int main()
+{
+  void_fp fp=g;
+  void_fp *p=&fp;
+
+  // may point anywhere, including to fp
+  long address;
+  void_fp *q=(void_fp *)address;
+  *q=f;
+
+  void_fp loaded=*p;
+  loaded();
+
+  return 0;
+}
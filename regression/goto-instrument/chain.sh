@@ -14,6 +14,19 @@ args=${@:1:$#-1}
 
 $goto_cc -o $name.gb $name.c
 # $goto_instrument --show-goto-functions $name.gb
+
+# one slice per property, each of which is shown and checked
+if echo "$args" | grep -q -- "--full-slice-each-property" ; then
+  slices=$(mktemp -d)
+  trap 'rm -rf "$slices"' EXIT
+  $goto_instrument $args $name.gb $slices/$name
+  for slice in $slices/$name.* ; do
+    $goto_instrument --show-goto-functions $slice
+    $cbmc $slice
+  done
+  exit 0
+fi
+
 $goto_instrument $args $name.gb ${name}-mod.gb
 if [ ! -e ${name}-mod.gb ] ; then
   cp $name.gb ${name}-mod.gb
@@ -0,0 +1,22 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x;
+
+void *worker(void *arg)
+{
+  int t=x;
+  x=t+1;
+  return 0;
+}
+
+int main()
+{
+  pthread_t t1, t2;
+  pthread_create(&t1, 0, worker, 0);
+  pthread_create(&t2, 0, worker, 0);
+  pthread_join(t1, 0);
+  pthread_join(t2, 0);
+  assert(x==2);
+  return 0;
+}
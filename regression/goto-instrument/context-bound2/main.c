@@ -0,0 +1,26 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x;
+pthread_mutex_t m;
+
+void *worker(void *arg)
+{
+  pthread_mutex_lock(&m);
+  int t=x;
+  x=t+1;
+  pthread_mutex_unlock(&m);
+  return 0;
+}
+
+int main()
+{
+  pthread_t t1, t2;
+  pthread_mutex_init(&m, 0);
+  pthread_create(&t1, 0, worker, 0);
+  pthread_create(&t2, 0, worker, 0);
+  pthread_join(t1, 0);
+  pthread_join(t2, 0);
+  assert(x==2);
+  return 0;
+}
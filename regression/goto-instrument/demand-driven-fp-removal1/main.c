@@ -0,0 +1,32 @@
+#include <stdio.h>
+
+void f1 (void) { printf("%i\n", 1); }
+void f2 (void) { printf("%i\n", 2); }
+void f3 (void) { printf("%i\n", 3); }
+void f4 (void) { printf("%i\n", 4); }
+
+typedef void(*void_fp)(void);
+
+// Take the address of all functions so that the type-based fallback
+// would consider all of them
+const void_fp fp_all[] = {f1, f2, f3, f4};
+
+void call(void_fp callback)
+{
+  callback();
+}
+
+void func()
+{
+  void_fp fp = f2;
+  fp = f3;
+  fp();
+}
+
+int main()
+{
+  func();
+  call(f4);
+
+  return 0;
+}
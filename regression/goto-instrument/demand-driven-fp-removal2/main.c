@@ -0,0 +1,23 @@
+#include <stdio.h>
+
+void f1 (void) { printf("%i\n", 1); }
+void f2 (void) { printf("%i\n", 2); }
+void f3 (void) { printf("%i\n", 3); }
+
+typedef void(*void_fp)(void);
+
+const void_fp fp_all[] = {f1, f2, f3};
+
+void_fp never(void)
+{
+  // there is no return value for the analysis to go by
+  for(;;);
+}
+
+int main()
+{
+  void_fp fp=never();
+  fp();
+
+  return 0;
+}
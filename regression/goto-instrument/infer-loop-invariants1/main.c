@@ -0,0 +1,19 @@
+int main()
+{
+  unsigned x=0, y=0;
+
+  while(1)
+  {
+    _Bool more;
+    if(!more)
+      break;
+
+    x++;
+    y++;
+
+    // not inductive by itself, but x==y is
+    __CPROVER_assert(x+y!=1, "x+y is even");
+  }
+
+  return 0;
+}
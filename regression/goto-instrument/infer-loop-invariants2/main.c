@@ -0,0 +1,16 @@
+int main()
+{
+  int x=0;
+  int *p=&x;
+
+  // the interval analysis does not see this write
+  *p=-5;
+
+  while(x<10)
+  {
+    __CPROVER_assert(x!=-5, "x is never -5");
+    x++;
+  }
+
+  return 0;
+}
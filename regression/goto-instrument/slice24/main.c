@@ -0,0 +1,14 @@
+int main()
+{
+  int x, y;
+
+  if(x>0)
+    y=x;
+  else
+    y=-x;
+
+  __CPROVER_assert(y>=0 || x==-2147483648, "absolute value");
+  __CPROVER_assert(x==x, "reflexive");
+
+  return 0;
+}
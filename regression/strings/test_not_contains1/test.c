@@ -0,0 +1,17 @@
+#include <assert.h>
+#include "../cprover-string-hack.h"
+
+
+int main()
+{
+  __CPROVER_string s1 = __CPROVER_string_literal("a1");
+  __CPROVER_string s2 = __CPROVER_string_literal("2b");
+  __CPROVER_string t = __CPROVER_string_concat(s1, s2);
+
+  // refuting each assertion requires the not_contains axioms, instantiated
+  // with the initial index set
+  assert(__CPROVER_string_contains(t, __CPROVER_string_literal("12")));
+  assert(__CPROVER_string_contains(t, __CPROVER_string_literal("a12b")));
+
+  return 0;
+}
@@ -12,8 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_AI_H
 #define CPROVER_ANALYSES_AI_H
 
+#include <algorithm>
 #include <map>
 #include <iosfwd>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <util/json.h>
 #include <util/xml.h>
@@ -351,46 +355,174 @@ public:
 
   domainT &operator[](locationt l)
   {
-    typename state_mapt::iterator it=state_map.find(l);
-    if(it==state_map.end())
+    domainT *state=find_domain(l);
+    if(state==nullptr)
       throw "failed to find state";
 
-    return it->second;
+    return *state;
   }
 
   const domainT &operator[](locationt l) const
   {
-    typename state_mapt::const_iterator it=state_map.find(l);
-    if(it==state_map.end())
+    const domainT *state=find_domain(l);
+    if(state==nullptr)
       throw "failed to find state";
 
-    return it->second;
+    return *state;
   }
 
   void clear() override
   {
     state_map.clear();
+    state_vector.clear();
+    owners.clear();
+    first_location=0;
     ai_baset::clear();
   }
 
 protected:
+  // States are found via a vector indexed by location number, which is
+  // dense and unique after goto_functionst::update(). The vector is sized
+  // when the analysis is initialized, and holds pointers only; a state is
+  // created once its location is first reached, such that locations the
+  // analysis never reaches cost no domain. Locations that are outside of
+  // that range, or whose number is already taken by another instruction,
+  // are kept in a hash map instead.
   typedef std::unordered_map<locationt, domainT, const_target_hash> state_mapt;
   state_mapt state_map;
 
+  std::vector<std::unique_ptr<domainT> > state_vector;
+  std::vector<const goto_programt::instructiont *> owners;
+  unsigned first_location=0;
+
+  void initialize(const goto_programt &goto_program) override
+  {
+    // when called for all functions, the vector is already sized
+    if(state_vector.empty() && !goto_program.instructions.empty())
+    {
+      unsigned first=goto_program.instructions.front().location_number;
+      unsigned last=first;
+
+      forall_goto_program_instructions(i_it, goto_program)
+      {
+        first=std::min(first, i_it->location_number);
+        last=std::max(last, i_it->location_number);
+      }
+
+      reserve_states(first, last);
+    }
+
+    ai_baset::initialize(goto_program);
+  }
+
+  void initialize(const goto_functionst::goto_functiont &goto_function)
+    override
+  {
+    ai_baset::initialize(goto_function);
+  }
+
+  void initialize(const goto_functionst &goto_functions) override
+  {
+    if(state_vector.empty())
+    {
+      bool empty=true;
+      unsigned first=0, last=0;
+
+      forall_goto_functions(f_it, goto_functions)
+        forall_goto_program_instructions(i_it, f_it->second.body)
+        {
+          if(empty || i_it->location_number<first)
+            first=i_it->location_number;
+          if(empty || i_it->location_number>last)
+            last=i_it->location_number;
+          empty=false;
+        }
+
+      if(!empty)
+        reserve_states(first, last);
+    }
+
+    ai_baset::initialize(goto_functions);
+  }
+
+  void reserve_states(unsigned first, unsigned last)
+  {
+    first_location=first;
+    state_vector.resize(last-first+1);
+    owners.resize(last-first+1, nullptr);
+  }
+
+  /// \return the state of \p l in state_vector, which is created for
+  ///   \p l if the slot is free and \p create is set, or nullptr if
+  ///   \p l is not kept there
+  domainT *vector_slot(locationt l, bool create)
+  {
+    const std::size_t index=l->location_number-first_location;
+
+    if(l->location_number<first_location || index>=state_vector.size())
+      return nullptr;
+
+    const goto_programt::instructiont *&owner=owners[index];
+
+    if(owner==&*l)
+      return state_vector[index].get();
+
+    if(owner==nullptr && create)
+    {
+      owner=&*l;
+      state_vector[index].reset(new domainT()); // calls default constructor
+      return state_vector[index].get();
+    }
+
+    return nullptr;
+  }
+
+  /// \return the state at \p l, or nullptr if there is none
+  domainT *find_domain(locationt l)
+  {
+    domainT *state=vector_slot(l, false);
+    if(state!=nullptr)
+      return state;
+
+    typename state_mapt::iterator it=state_map.find(l);
+    return it==state_map.end()?nullptr:&it->second;
+  }
+
+  const domainT *find_domain(locationt l) const
+  {
+    return const_cast<ait *>(this)->find_domain(l);
+  }
+
+  /// Applies \p f to every state
+  template<typename functiont>
+  void for_each_state(functiont f)
+  {
+    for(auto &state : state_vector)
+      if(state!=nullptr)
+        f(*state);
+
+    for(auto &state : state_map)
+      f(state.second);
+  }
+
   // this one creates states, if need be
   virtual statet &get_state(locationt l) override
   {
+    domainT *state=vector_slot(l, true);
+    if(state!=nullptr)
+      return *state;
+
     return state_map[l]; // calls default constructor
   }
 
   // this one just finds states
   const statet &find_state(locationt l) const override
   {
-    typename state_mapt::const_iterator it=state_map.find(l);
-    if(it==state_map.end())
+    const domainT *state=find_domain(l);
+    if(state==nullptr)
       throw "failed to find state";
 
-    return it->second;
+    return *state;
   }
 
   bool merge(const statet &src, locationt from, locationt to) override
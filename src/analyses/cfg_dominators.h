@@ -17,6 +17,8 @@ Author: Georg Weissenbacher, georg@weissenbacher.name
 #include <map>
 #include <iosfwd>
 #include <cassert>
+#include <limits>
+#include <vector>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_program.h>
@@ -38,6 +40,16 @@ public:
 
   void operator()(P &program);
 
+  /// Computes the dominator tree only, but not the sets of dominators,
+  /// which are quadratic in the size of the program
+  void compute_tree(P &program);
+
+  /// \return true if \p dominator dominates \p node
+  bool dominates(T dominator, T node) const;
+
+  /// \return true if \p node is reachable from the entry node
+  bool is_reachable(T node) const;
+
   T entry_node;
 
   void output(std::ostream &) const;
@@ -45,8 +57,19 @@ public:
 protected:
   void initialise(P &program);
   void fixedpoint(P &program);
+  void build_tree(P &program);
+
+  // the dominator tree, indexed by the nodes of the CFG, with each
+  // subtree numbered by an interval, such that dominance is containment
+  static const std::size_t no_node=std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> immediate_dominators;
+  std::vector<std::size_t> tree_entry;
+  std::vector<std::size_t> tree_exit;
 };
 
+template <class P, class T, bool post_dom>
+const std::size_t cfg_dominators_templatet<P, T, post_dom>::no_node;
+
 /// Print the result of the dominator computation
 template <class P, class T, bool post_dom>
 std::ostream &operator << (
@@ -63,6 +86,186 @@ void cfg_dominators_templatet<P, T, post_dom>::operator()(P &program)
 {
   initialise(program);
   fixedpoint(program);
+  build_tree(program);
+}
+
+/// Compute the dominator tree
+template <class P, class T, bool post_dom>
+void cfg_dominators_templatet<P, T, post_dom>::compute_tree(P &program)
+{
+  initialise(program);
+  build_tree(program);
+}
+
+template <class P, class T, bool post_dom>
+bool cfg_dominators_templatet<P, T, post_dom>::dominates(
+  T dominator,
+  T node) const
+{
+  typename cfgt::entry_mapt::const_iterator d_it=
+    cfg.entry_map.find(dominator);
+  typename cfgt::entry_mapt::const_iterator n_it=cfg.entry_map.find(node);
+
+  if(d_it==cfg.entry_map.end() || n_it==cfg.entry_map.end())
+    return false;
+
+  const std::size_t d=d_it->second;
+  const std::size_t n=n_it->second;
+
+  if(immediate_dominators[n]==no_node)
+    return false;
+
+  return tree_entry[d]<=tree_entry[n] && tree_exit[n]<=tree_exit[d];
+}
+
+template <class P, class T, bool post_dom>
+bool cfg_dominators_templatet<P, T, post_dom>::is_reachable(T node) const
+{
+  typename cfgt::entry_mapt::const_iterator n_it=cfg.entry_map.find(node);
+
+  return n_it!=cfg.entry_map.end() &&
+         immediate_dominators[n_it->second]!=no_node;
+}
+
+/// Computes the immediate dominators with the algorithm by Cooper, Harvey
+/// and Kennedy ("A Simple, Fast Dominance Algorithm"), which iterates
+/// over the nodes in reverse postorder, and numbers the resulting tree
+template <class P, class T, bool post_dom>
+void cfg_dominators_templatet<P, T, post_dom>::build_tree(P &program)
+{
+  typedef typename cfgt::edgest edgest;
+
+  const std::size_t size=cfg.size();
+
+  immediate_dominators.assign(size, no_node);
+  tree_entry.assign(size, 0);
+  tree_exit.assign(size, 0);
+
+  if(cfg.nodes_empty(program))
+    return;
+
+  if(post_dom)
+    entry_node=cfg.get_last_node(program);
+  else
+    entry_node=cfg.get_first_node(program);
+  const std::size_t root=cfg.entry_map[entry_node];
+
+  // number the nodes in postorder by depth-first search
+  std::vector<std::size_t> postorder;
+  std::vector<std::size_t> order(size, no_node);
+  std::vector<std::pair<std::size_t, typename edgest::const_iterator>> stack;
+
+  order[root]=size;
+  stack.push_back(std::make_pair(root, (post_dom?cfg[root].in:
+                                                 cfg[root].out).begin()));
+
+  while(!stack.empty())
+  {
+    const std::size_t n=stack.back().first;
+    const edgest &successors=post_dom?cfg[n].in:cfg[n].out;
+
+    if(stack.back().second==successors.end())
+    {
+      order[n]=postorder.size();
+      postorder.push_back(n);
+      stack.pop_back();
+      continue;
+    }
+
+    const std::size_t s=(stack.back().second++)->first;
+
+    if(order[s]==no_node)
+    {
+      order[s]=size; // on the stack
+      stack.push_back(std::make_pair(s, (post_dom?cfg[s].in:
+                                                  cfg[s].out).begin()));
+    }
+  }
+
+  immediate_dominators[root]=root;
+
+  for(bool changed=true; changed; )
+  {
+    changed=false;
+
+    for(typename std::vector<std::size_t>::const_reverse_iterator
+        it=postorder.rbegin();
+        it!=postorder.rend();
+        ++it)
+    {
+      const std::size_t n=*it;
+
+      if(n==root)
+        continue;
+
+      std::size_t new_idom=no_node;
+
+      for(const auto &edge : (post_dom?cfg[n].out:cfg[n].in))
+      {
+        std::size_t p=edge.first;
+
+        if(immediate_dominators[p]==no_node)
+          continue;
+
+        if(new_idom==no_node)
+        {
+          new_idom=p;
+          continue;
+        }
+
+        // intersect, walking up the tree
+        std::size_t q=new_idom;
+
+        while(p!=q)
+        {
+          while(order[p]<order[q])
+            p=immediate_dominators[p];
+          while(order[q]<order[p])
+            q=immediate_dominators[q];
+        }
+
+        new_idom=p;
+      }
+
+      if(immediate_dominators[n]!=new_idom)
+      {
+        immediate_dominators[n]=new_idom;
+        changed=true;
+      }
+    }
+  }
+
+  // number the tree such that each subtree is an interval
+  std::vector<std::vector<std::size_t>> children(size);
+
+  for(const auto n : postorder)
+    if(n!=root)
+      children[immediate_dominators[n]].push_back(n);
+
+  std::size_t counter=0;
+  std::vector<std::pair<std::size_t, std::size_t>> tree_stack;
+
+  tree_entry[root]=++counter;
+  tree_stack.push_back(std::make_pair(root, 0));
+
+  while(!tree_stack.empty())
+  {
+    const std::size_t n=tree_stack.back().first;
+    const std::size_t c=tree_stack.back().second;
+
+    if(c==children[n].size())
+    {
+      tree_exit[n]=++counter;
+      tree_stack.pop_back();
+      continue;
+    }
+
+    tree_stack.back().second++;
+
+    const std::size_t child=children[n][c];
+    tree_entry[child]=++counter;
+    tree_stack.push_back(std::make_pair(child, 0));
+  }
 }
 
 /// Initialises the elements of the fixed point analysis
@@ -494,31 +494,31 @@ void constant_propagator_ait::replace(
 {
   Forall_goto_program_instructions(it, goto_function.body)
   {
-    state_mapt::iterator s_it = state_map.find(it);
+    constant_propagator_domaint *state=find_domain(it);
 
-    if(s_it == state_map.end())
+    if(state==nullptr)
       continue;
 
-    replace_types_rec(s_it->second.values.replace_const, it->code);
-    replace_types_rec(s_it->second.values.replace_const, it->guard);
+    replace_types_rec(state->values.replace_const, it->code);
+    replace_types_rec(state->values.replace_const, it->guard);
 
     if(it->is_goto() || it->is_assume() || it->is_assert())
     {
       replace_array_symbol(it->guard);
-      s_it->second.values.replace_const(it->guard);
+      state->values.replace_const(it->guard);
       it->guard = simplify_expr(it->guard, ns);
     }
     else if(it->is_assign())
     {
       exprt &rhs = to_code_assign(it->code).rhs();
-      s_it->second.values.replace_const(rhs);
+      state->values.replace_const(rhs);
       rhs = simplify_expr(rhs, ns);
       if (rhs.id()==ID_constant)
         rhs.add_source_location()=it->code.op0().source_location();
     }
     else if(it->is_function_call())
     {
-      s_it->second.values.replace_const(
+      state->values.replace_const(
         to_code_function_call(it->code).function());
       simplify_expr(to_code_function_call(it->code).function(), ns);
 
@@ -528,14 +528,14 @@ void constant_propagator_ait::replace(
       for(exprt::operandst::iterator o_it = args.begin();
           o_it != args.end(); ++o_it)
       {
-        s_it->second.values.replace_const(*o_it);
+        state->values.replace_const(*o_it);
         *o_it = simplify_expr(*o_it, ns);
       }
     }
     else if(it->is_other())
     {
       if(it->code.get_statement()==ID_expression)
-        s_it->second.values.replace_const(it->code);
+        state->values.replace_const(it->code);
     }
   }
 }
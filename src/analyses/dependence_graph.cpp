@@ -315,9 +315,11 @@ void dependence_grapht::add_dep(
   goto_programt::const_targett from,
   goto_programt::const_targett to)
 {
-  const node_indext n_from=state_map[from].get_node_id();
+  const node_indext n_from=
+    static_cast<dep_graph_domaint &>(get_state(from)).get_node_id();
   assert(n_from<size());
-  const node_indext n_to=state_map[to].get_node_id();
+  const node_indext n_to=
+    static_cast<dep_graph_domaint &>(get_state(to)).get_node_id();
   assert(n_to<size());
 
   // add_edge is redundant as the subsequent operations also insert
@@ -198,17 +198,18 @@ public:
 
   virtual statet &get_state(goto_programt::const_targett l)
   {
-    std::pair<state_mapt::iterator, bool> entry=
-      state_map.insert(std::make_pair(l, dep_graph_domaint()));
+    const bool is_new=find_domain(l)==nullptr;
+    dep_graph_domaint &state=
+      static_cast<dep_graph_domaint &>(ait<dep_graph_domaint>::get_state(l));
 
-    if(entry.second)
+    if(is_new)
     {
       const node_indext node_id=add_node();
-      entry.first->second.set_node_id(node_id);
+      state.set_node_id(node_id);
       nodes[node_id].PC=l;
     }
 
-    return entry.first->second;
+    return state;
   }
 
 protected:
@@ -18,14 +18,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 void invariant_propagationt::make_all_true()
 {
-  for(auto &state : state_map)
-    state.second.invariant_set.make_true();
+  for_each_state([](invariant_set_domaint &state)
+    {
+      state.invariant_set.make_true();
+    });
 }
 
 void invariant_propagationt::make_all_false()
 {
-  for(auto &state : state_map)
-    state.second.invariant_set.make_false();
+  for_each_state([](invariant_set_domaint &state)
+    {
+      state.invariant_set.make_false();
+    });
 }
 
 void invariant_propagationt::add_objects(
@@ -210,7 +214,7 @@ void invariant_propagationt::initialize(const goto_programt &goto_program)
 
   forall_goto_program_instructions(it, goto_program)
   {
-    invariant_sett &s=state_map[it].invariant_set;
+    invariant_sett &s=(*this)[it].invariant_set;
 
     if(it==goto_program.instructions.begin())
       s.make_true();
@@ -247,11 +251,11 @@ void invariant_propagationt::simplify(goto_programt &goto_program)
       continue;
 
     // find invariant set
-    state_mapt::const_iterator s_it=state_map.find(i_it);
-    if(s_it==state_map.end())
+    const invariant_set_domaint *state=find_domain(i_it);
+    if(state==nullptr)
       continue;
 
-    const invariant_sett &invariant_set=s_it->second.invariant_set;
+    const invariant_sett &invariant_set=state->invariant_set;
 
     exprt simplified_guard(i_it->guard);
 
@@ -39,6 +39,7 @@ public:
 
   void output(std::ostream &) const;
 
+  /// Only the dominator tree is available, not the sets of dominators
   const cfg_dominators_templatet<P, T, false> &get_dominator_info() const
   {
     return cfg_dominators;
@@ -80,11 +81,8 @@ void show_natural_loops(const goto_functionst &goto_functions);
 template<class P, class T>
 void natural_loops_templatet<P, T>::compute(P &program)
 {
-  cfg_dominators(program);
-
-#ifdef DEBUG
-  cfg_dominators.output(std::cout);
-#endif
+  // the sets of dominators are not needed, which saves quadratic effort
+  cfg_dominators.compute_tree(program);
 
   // find back-edges m->n
   for(T m_it=program.instructions.begin();
@@ -97,15 +95,12 @@ void natural_loops_templatet<P, T>::compute(P &program)
       {
         if(target->location_number<=m_it->location_number)
         {
-          const nodet &node=
-            cfg_dominators.cfg[cfg_dominators.cfg.entry_map[m_it]];
-
 #ifdef DEBUG
           std::cout << "Computing loop for "
                     << m_it->location_number << " -> "
                     << target->location_number << "\n";
 #endif
-          if(node.dominators.find(target)!=node.dominators.end())
+          if(cfg_dominators.dominates(target, m_it))
           {
             compute_natural_loop(m_it, target);
           }
@@ -26,6 +26,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ansi_c_internal_additions.h"
 #include "type2name.h"
 
+std::shared_ptr<ansi_c_languaget::built_in_prefixt>
+  ansi_c_languaget::last_built_in_prefix;
+
 std::set<std::string> ansi_c_languaget::extensions() const
 {
   return { "c", "i" };
@@ -68,23 +71,53 @@ bool ansi_c_languaget::parse(
 
   std::string code;
   ansi_c_internal_additions(code);
-  std::istringstream codestr(code);
+
+  // the built-in declarations depend on the configuration, which is
+  // mostly reflected in the code
+  std::string key=code;
+  key+=std::to_string(static_cast<int>(config.ansi_c.mode));
+  key+=config.ansi_c.for_has_scope?'1':'0';
+  key+=config.ansi_c.single_precision_constant?'1':'0';
+  key+=config.ansi_c.string_abstraction?'1':'0';
 
   ansi_c_parser.clear();
-  ansi_c_parser.set_file(ID_built_in);
-  ansi_c_parser.in=&codestr;
   ansi_c_parser.set_message_handler(get_message_handler());
   ansi_c_parser.for_has_scope=config.ansi_c.for_has_scope;
   ansi_c_parser.cpp98=false; // it's not C++
   ansi_c_parser.cpp11=false; // it's not C++
   ansi_c_parser.mode=config.ansi_c.mode;
 
-  ansi_c_scanner_init();
+  bool result=false;
 
-  bool result=ansi_c_parser.parse();
+  if(last_built_in_prefix!=nullptr &&
+     last_built_in_prefix->key==key)
+  {
+    // continue where the built-in declarations left the parser
+    ansi_c_parser.scopes=last_built_in_prefix->scopes;
+  }
+  else
+  {
+    std::istringstream codestr(code);
+
+    ansi_c_parser.set_file(ID_built_in);
+    ansi_c_parser.in=&codestr;
+    ansi_c_scanner_init();
+
+    result=ansi_c_parser.parse();
+
+    if(!result)
+    {
+      last_built_in_prefix=std::make_shared<built_in_prefixt>();
+      last_built_in_prefix->key.swap(key);
+      last_built_in_prefix->parse_tree.swap(ansi_c_parser.parse_tree);
+      last_built_in_prefix->scopes=ansi_c_parser.scopes;
+    }
+  }
 
   if(!result)
   {
+    built_in_prefix=last_built_in_prefix;
+
     ansi_c_parser.set_line_no(0);
     ansi_c_parser.set_file(path);
     ansi_c_parser.in=&i_preprocessed;
@@ -101,12 +134,44 @@ bool ansi_c_languaget::parse(
   return result;
 }
 
+/// type checks the built-in declarations, unless this has been done for
+/// another unit already
+/// \return true on error, false otherwise
+bool ansi_c_languaget::typecheck_built_in_prefix(const std::string &module)
+{
+  if(!built_in_prefix->typechecked)
+  {
+    built_in_prefix->typechecked=true;
+    built_in_prefix->typecheck_failed=
+      ansi_c_typecheck(
+        built_in_prefix->parse_tree,
+        built_in_prefix->symbol_table,
+        module,
+        get_message_handler());
+  }
+
+  return built_in_prefix->typecheck_failed;
+}
+
 bool ansi_c_languaget::typecheck(
   symbol_tablet &symbol_table,
   const std::string &module)
 {
   symbol_tablet new_symbol_table;
 
+  if(built_in_prefix!=nullptr)
+  {
+    if(typecheck_built_in_prefix(module))
+      return true;
+
+    forall_symbols(it, built_in_prefix->symbol_table.symbols)
+    {
+      symbolt symbol=it->second;
+      symbol.module=module;
+      new_symbol_table.add(symbol);
+    }
+  }
+
   if(ansi_c_typecheck(
     parse_tree,
     new_symbol_table,
@@ -10,9 +10,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANSI_C_ANSI_C_LANGUAGE_H
 #define CPROVER_ANSI_C_ANSI_C_LANGUAGE_H
 
+#include <memory>
+
 #include <util/language.h>
+#include <util/symbol_table.h>
 
 #include "ansi_c_parse_tree.h"
+#include "ansi_c_scope.h"
 
 class ansi_c_languaget:public languaget
 {
@@ -71,6 +75,31 @@ public:
 protected:
   ansi_c_parse_treet parse_tree;
   std::string parse_path;
+
+  // The built-in declarations are the same for every translation unit.
+  // They are parsed and type checked once, and the result is shared by
+  // the units that are parsed with the same configuration.
+  struct built_in_prefixt
+  {
+    std::string key;
+    ansi_c_parse_treet parse_tree;
+    std::list<ansi_c_scopet> scopes;
+    bool typechecked;
+    bool typecheck_failed;
+    symbol_tablet symbol_table;
+
+    built_in_prefixt():typechecked(false), typecheck_failed(false)
+    {
+    }
+  };
+
+  // the prefix the parse tree of this unit continues
+  std::shared_ptr<built_in_prefixt> built_in_prefix;
+
+  // the prefix of the unit parsed last
+  static std::shared_ptr<built_in_prefixt> last_built_in_prefix;
+
+  bool typecheck_built_in_prefix(const std::string &module);
 };
 
 languaget *new_ansi_c_language();
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "bmc.h"
 
 #include <iostream>
+#include <set>
 
 #include <util/time_stopping.h>
 #include <util/xml.h>
@@ -44,6 +45,7 @@ public:
 
   // gets called by prop_covert
   virtual void satisfying_assignment();
+  virtual void satisfying_assignment_extended();
 
   struct goalt
   {
@@ -101,6 +103,10 @@ public:
   {
     goto_tracet goto_trace;
     std::vector<irep_idt> covered_goals;
+
+    // all goals satisfied by the test, including those that
+    // were covered by earlier tests, for minimization
+    std::vector<irep_idt> satisfied_goals;
   };
 
   inline irep_idt id(goto_programt::const_targett loc)
@@ -139,6 +145,8 @@ protected:
   const goto_functionst &goto_functions;
   prop_convt &solver;
   bmct &bmc;
+
+  void minimize_tests();
 };
 
 void bmc_covert::satisfying_assignment()
@@ -146,12 +154,14 @@ void bmc_covert::satisfying_assignment()
   tests.push_back(testt());
   testt &test = tests.back();
 
+  const bool minimize=bmc.options.get_bool_option("cover-minimize");
+
   for(auto &goal_pair : goal_map)
   {
     goalt &g=goal_pair.second;
 
     // covered already?
-    if(g.satisfied)
+    if(g.satisfied && !minimize)
       continue;
 
     // check whether satisfied
@@ -161,9 +171,14 @@ void bmc_covert::satisfying_assignment()
 
       if(solver.l_get(cond).is_true())
       {
-        status() << "Covered " << g.description << messaget::eom;
-        g.satisfied=true;
-        test.covered_goals.push_back(goal_pair.first);
+        test.satisfied_goals.push_back(goal_pair.first);
+
+        if(!g.satisfied)
+        {
+          status() << "Covered " << g.description << messaget::eom;
+          g.satisfied=true;
+          test.covered_goals.push_back(goal_pair.first);
+        }
         break;
       }
     }
@@ -190,6 +205,71 @@ void bmc_covert::satisfying_assignment()
   #endif
 }
 
+void bmc_covert::satisfying_assignment_extended()
+{
+  // the new assignment satisfies the goals of the previous one
+  std::vector<irep_idt> covered_goals;
+  covered_goals.swap(tests.back().covered_goals);
+  tests.pop_back();
+
+  satisfying_assignment();
+
+  testt &test=tests.back();
+  test.covered_goals.insert(
+    test.covered_goals.begin(), covered_goals.begin(), covered_goals.end());
+}
+
+/// Greedy set cover: repeatedly keep the test that satisfies the most
+/// goals that no kept test covers yet, and drop the remaining tests
+void bmc_covert::minimize_tests()
+{
+  std::set<irep_idt> covered;
+  std::vector<bool> kept(tests.size(), false);
+  testst result;
+
+  while(true)
+  {
+    std::size_t best=tests.size(), best_count=0;
+
+    for(std::size_t i=0; i<tests.size(); i++)
+    {
+      if(kept[i])
+        continue;
+
+      std::size_t count=0;
+
+      for(const auto &goal_id : tests[i].satisfied_goals)
+        if(covered.find(goal_id)==covered.end())
+          count++;
+
+      if(count>best_count)
+      {
+        best=i;
+        best_count=count;
+      }
+    }
+
+    if(best_count==0)
+      break;
+
+    kept[best]=true;
+
+    testt &test=tests[best];
+    test.covered_goals.clear();
+
+    for(const auto &goal_id : test.satisfied_goals)
+      if(covered.insert(goal_id).second)
+        test.covered_goals.push_back(goal_id);
+
+    result.push_back(test);
+  }
+
+  statistics() << "Minimized test-suite from " << tests.size()
+               << " to " << result.size() << " test(s)" << eom;
+
+  tests.swap(result);
+}
+
 bool bmc_covert::operator()()
 {
   status() << "Passing problem to " << solver.decision_procedure_text() << eom;
@@ -247,6 +327,8 @@ bool bmc_covert::operator()()
   cover_goalst cover_goals(solver);
 
   cover_goals.register_observer(*this);
+  cover_goals.extend_assignments=
+    bmc.options.get_bool_option("cover-minimize");
 
   for(const auto &g : goal_map)
   {
@@ -260,6 +342,9 @@ bool bmc_covert::operator()()
 
   cover_goals();
 
+  if(bmc.options.get_bool_option("cover-minimize"))
+    minimize_tests();
+
   // output runtime
 
   {
@@ -0,0 +1,82 @@
+/*******************************************************************\
+
+Module: Bounded Model Checking for k-Induction
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Bounded Model Checking for k-Induction
+
+#include "bmc_k_induction.h"
+
+#include <util/arith_tools.h>
+#include <util/std_expr.h>
+#include <util/time_stopping.h>
+
+#include "counterexample_beautification.h"
+
+safety_checkert::resultt bmc_k_inductiont::decide(
+  const goto_functionst &,
+  prop_convt &prop_conv)
+{
+  prop_conv.set_message_handler(get_message_handler());
+
+  if(!prop_conv.has_set_assumptions())
+  {
+    error() << "k-induction requires a decision procedure "
+            << "that supports assumptions" << eom;
+    return resultt::ERROR;
+  }
+
+  do_conversion();
+  converted=true;
+
+  return resultt::SAFE;
+}
+
+safety_checkert::resultt bmc_k_inductiont::check(
+  unsigned value,
+  const goto_functionst &goto_functions)
+{
+  // there were no properties left to check after symbolic execution
+  if(!converted)
+    return resultt::SAFE;
+
+  bvt assumptions;
+  assumptions.push_back(
+    prop_conv.convert(equal_exprt(k, from_integer(value, k.type()))));
+  prop_conv.set_assumptions(assumptions);
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  absolute_timet sat_start=current_time();
+  const decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+  absolute_timet sat_stop=current_time();
+
+  status() << "Runtime decision procedure: "
+           << (sat_stop-sat_start) << "s" << eom;
+
+  switch(dec_result)
+  {
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return resultt::SAFE;
+
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    if(options.get_bool_option("trace"))
+    {
+      if(options.get_bool_option("beautify"))
+        counterexample_beautificationt()(
+          dynamic_cast<bv_cbmct &>(prop_conv), equation, ns);
+
+      error_trace();
+      output_graphml(resultt::UNSAFE, goto_functions);
+    }
+    return resultt::UNSAFE;
+
+  default:
+    error() << "decision procedure failed" << eom;
+    return resultt::ERROR;
+  }
+}
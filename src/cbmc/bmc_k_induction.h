@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Bounded Model Checking for k-Induction
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Bounded Model Checking for k-Induction
+
+#ifndef CPROVER_CBMC_BMC_K_INDUCTION_H
+#define CPROVER_CBMC_BMC_K_INDUCTION_H
+
+#include "bmc.h"
+
+/// Checks the base case or the step case of k-induction for each k up to
+/// a bound, on a program instrumented by k_induction(..., max_k, k): the
+/// program is symbolically executed and converted by run() only once,
+/// and each k is then checked by solving under the assumption that the
+/// symbol k has that value, reusing the solver.
+class bmc_k_inductiont:public bmct
+{
+public:
+  bmc_k_inductiont(
+    const optionst &_options,
+    const symbol_tablet &_symbol_table,
+    message_handlert &_message_handler,
+    prop_convt &_prop_conv,
+    const exprt &_k):
+    bmct(_options, _symbol_table, _message_handler, _prop_conv),
+    k(_k),
+    converted(false)
+  {
+  }
+
+  /// \return SAFE if the assertions hold for the given value of k;
+  ///   for UNSAFE, the error trace is output if requested
+  resultt check(unsigned value, const goto_functionst &goto_functions);
+
+protected:
+  const exprt k;
+  bool converted;
+
+  // converts the formula, but does not solve it yet
+  virtual resultt decide(
+    const goto_functionst &,
+    prop_convt &) override;
+};
+
+#endif // CPROVER_CBMC_BMC_K_INDUCTION_H
@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/unicode.h>
 #include <util/memory_info.h>
 #include <util/invariant.h>
+#include <util/c_types.h>
 
 #include <ansi-c/c_preprocess.h>
 
@@ -54,6 +55,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
 #include <goto-instrument/cover.h>
+#include <goto-instrument/k_induction.h>
+#include <goto-instrument/code_contracts.h>
 
 #include <pointer-analysis/add_failed_symbols.h>
 
@@ -61,6 +64,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cbmc_solvers.h"
 #include "bmc.h"
+#include "bmc_k_induction.h"
+#include "contract_cache.h"
 #include "version.h"
 #include "xml_interface.h"
 
@@ -115,6 +120,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("cover"))
     options.set_option("cover", cmdline.get_values("cover"));
 
+  if(cmdline.isset("cover-minimize"))
+    options.set_option("cover-minimize", true);
+
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
 
@@ -474,6 +482,12 @@ int cbmc_parse_optionst::doit()
   if(options.get_bool_option("java-unwind-enum-static"))
     remove_static_init_loops(symbol_table, goto_functions, options);
 
+  if(cmdline.isset("k-induction"))
+    return do_k_induction(options, goto_functions);
+
+  if(cmdline.isset("check-contracts"))
+    return do_check_contracts(options, goto_functions);
+
   // get solver
   cbmc_solverst cbmc_solvers(options, symbol_table, ui_message_handler);
   cbmc_solvers.set_ui(get_ui());
@@ -898,6 +912,221 @@ bool cbmc_parse_optionst::process_goto_program(
   return false;
 }
 
+/// Tries k-induction for k=1, 2, ... up to the given bound: the base
+/// case checks the properties for the first k iterations of each loop,
+/// and the step case checks that k iterations in which the properties
+/// hold are followed by one in which they hold, too. Each case is built
+/// for the largest k, and is symbolically executed and converted once;
+/// every k is then checked by the same solver, under an assumption that
+/// selects it.
+///
+/// The step case havocs the variables each loop assigns at its head.
+/// Only if that covers everything the loop may modify, i.e., there are
+/// no assignments to array elements or struct members, no calls and no
+/// inner loops, is this an induction step, and are the properties
+/// proved once both cases hold. Otherwise, the result is inconclusive.
+int cbmc_parse_optionst::do_k_induction(
+  const optionst &options,
+  const goto_functionst &goto_functions)
+{
+  const unsigned max_k=
+    unsafe_string2unsigned(cmdline.get_value("k-induction"));
+
+  // a free variable of the formulas that selects the k
+  exprt k(ID_nondet_symbol, unsigned_int_type());
+  k.set(ID_identifier, "k_induction::k");
+
+  goto_functionst base_instance;
+  base_instance.copy_from(goto_functions);
+  k_induction(base_instance, true, false, max_k, k);
+  base_instance.update();
+
+  goto_functionst step_instance;
+  step_instance.copy_from(goto_functions);
+  const bool havoc_incomplete=
+    k_induction(step_instance, false, true, max_k, k);
+  step_instance.update();
+
+  cbmc_solverst cbmc_solvers(options, symbol_table, ui_message_handler);
+  cbmc_solvers.set_ui(get_ui());
+
+  std::unique_ptr<cbmc_solverst::solvert> base_solver, step_solver;
+
+  try
+  {
+    base_solver=cbmc_solvers.get_solver();
+    step_solver=cbmc_solvers.get_solver();
+  }
+
+  catch(const char *error_msg)
+  {
+    error() << error_msg << eom;
+    return 1; // should contemplate EX_SOFTWARE from sysexits.h
+  }
+
+  bmc_k_inductiont base_bmc(
+    options, symbol_table, ui_message_handler, base_solver->prop_conv(), k);
+  base_bmc.set_ui(get_ui());
+
+  bmc_k_inductiont step_bmc(
+    options, symbol_table, ui_message_handler, step_solver->prop_conv(), k);
+  step_bmc.set_ui(get_ui());
+
+  status() << "k-induction: base case up to k=" << max_k << eom;
+
+  if(base_bmc.run(base_instance)==safety_checkert::resultt::ERROR)
+    return 6;
+
+  status() << "k-induction: step case up to k=" << max_k << eom;
+
+  if(step_bmc.run(step_instance)==safety_checkert::resultt::ERROR)
+    return 6;
+
+  for(unsigned i=1; i<=max_k; i++)
+  {
+    status() << "k-induction: base case for k=" << i << eom;
+
+    switch(base_bmc.check(i, base_instance))
+    {
+    case safety_checkert::resultt::SAFE:
+      break;
+
+    case safety_checkert::resultt::UNSAFE:
+      result() << "k-induction: base case fails for k=" << i << eom;
+      return 10;
+
+    case safety_checkert::resultt::ERROR:
+      return 6;
+    }
+
+    status() << "k-induction: step case for k=" << i << eom;
+
+    switch(step_bmc.check(i, step_instance))
+    {
+    case safety_checkert::resultt::SAFE:
+      result() << "k-induction: step case holds for k=" << i << eom;
+
+      if(havoc_incomplete)
+      {
+        warning() << "k-induction: a loop modifies locations that the "
+                  << "step case does not havoc, which is hence no "
+                  << "induction step" << eom;
+        result() << "k-induction: inconclusive" << eom;
+        return 6;
+      }
+
+      result() << "k-induction: properties proved" << eom;
+      return 0;
+
+    case safety_checkert::resultt::UNSAFE:
+      break;
+
+    case safety_checkert::resultt::ERROR:
+      return 6;
+    }
+  }
+
+  result() << "k-induction: inconclusive for k up to " << max_k << eom;
+  return 6;
+}
+
+/// Verifies the program modularly: each function with a contract is
+/// checked against it, with the calls it makes to other functions with a
+/// contract replaced by their contract, and so is the entry point. The
+/// checks are independent of each other. Proved contracts are remembered
+/// in the file given with --contract-cache, and are not checked again
+/// until the function, or anything its proof depends on, changes.
+int cbmc_parse_optionst::do_check_contracts(
+  const optionst &options,
+  const goto_functionst &goto_functions)
+{
+  const namespacet ns(symbol_table);
+  contract_cachet contract_cache(
+    goto_functions, ns, options, ui_message_handler);
+
+  const std::string cache_file=cmdline.get_value("contract-cache");
+
+  if(!cache_file.empty() && contract_cache.read(cache_file))
+    return 6;
+
+  // the entry point last, as it relies on all other contracts
+  std::vector<irep_idt> tasks;
+
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.type.find(ID_C_spec_ensures).is_not_nil())
+      tasks.push_back(f_it->first);
+
+  tasks.push_back(goto_functions.entry_point());
+
+  cbmc_solverst cbmc_solvers(options, symbol_table, ui_message_handler);
+  cbmc_solvers.set_ui(get_ui());
+
+  std::size_t failed=0;
+
+  for(const auto &function : tasks)
+  {
+    const bool is_entry_point=function==goto_functions.entry_point();
+
+    if(contract_cache.is_proved(function))
+    {
+      status() << "Contract of " << function << ": proved before" << eom;
+      continue;
+    }
+
+    status() << (is_entry_point?"Checking ":"Checking contract of ")
+             << function << eom;
+
+    goto_functionst instance;
+    instance.copy_from(goto_functions);
+    apply_code_contracts(symbol_table, instance);
+
+    if(!is_entry_point)
+      check_code_contract(symbol_table, instance, function);
+
+    instance.update();
+
+    std::unique_ptr<cbmc_solverst::solvert> cbmc_solver;
+
+    try
+    {
+      cbmc_solver=cbmc_solvers.get_solver();
+    }
+
+    catch(const char *error_msg)
+    {
+      error() << error_msg << eom;
+      return 1; // should contemplate EX_SOFTWARE from sysexits.h
+    }
+
+    bmct bmc(
+      options, symbol_table, ui_message_handler, cbmc_solver->prop_conv());
+    bmc.set_ui(get_ui());
+
+    switch(bmc.run(instance))
+    {
+    case safety_checkert::resultt::SAFE:
+      contract_cache.insert_proof(function);
+      break;
+
+    case safety_checkert::resultt::UNSAFE:
+      failed++;
+      break;
+
+    case safety_checkert::resultt::ERROR:
+      return 6;
+    }
+  }
+
+  result() << "Contracts: " << tasks.size() << " total, "
+           << contract_cache.number_of_hits() << " proved before, "
+           << failed << " failed" << eom;
+
+  if(!cache_file.empty() && contract_cache.write(cache_file))
+    return 6;
+
+  return failed==0?0:10;
+}
+
 /// invoke main modules
 int cbmc_parse_optionst::do_bmc(
   bmct &bmc,
@@ -1010,6 +1239,8 @@ void cbmc_parse_optionst::help()
     " --no-assumptions             ignore user assumptions\n"
     " --error-label label          check that label is unreachable\n"
     " --cover CC                   create test-suite with coverage criterion CC\n" // NOLINT(*)
+    " --cover-minimize             cover as many goals as possible per test,\n"
+    "                              and minimize the test-suite\n"
     " --mm MM                      memory consistency model for concurrent programs\n" // NOLINT(*)
     "\n"
     "Java Bytecode frontend options:\n"
@@ -1020,6 +1251,10 @@ void cbmc_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --java-cp-include-files      regexp or JSON list of files to load (with '@' prefix)\n"
     " --java-unwind-enum-static    try to unwind loops in static initialization of enums\n"
+    " --java-method-cache file     keep converted Java methods in file across runs\n"
+    " --lazy-methods               only convert methods reachable from the entry point\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --lazy-methods-context-sensitive  also use the types of the receivers at the call sites\n"
     "\n"
     "Semantic transformations:\n"
     " --nondet-static              add nondeterministic initialization of variables with static lifetime\n" // NOLINT(*)
@@ -1035,6 +1270,11 @@ void cbmc_parse_optionst::help()
     " --slice-formula              remove assignments unrelated to property\n"
     " --unwinding-assertions       generate unwinding assertions\n"
     " --partial-loops              permit paths with partial loops\n"
+    " --k-induction k              prove the properties by k-induction,\n"
+    "                              trying 1, ..., k\n"
+    " --check-contracts            check each function against its contract,\n" // NOLINT(*)
+    "                              using the contracts of the callees\n"
+    " --contract-cache file        do not check contracts proved before\n"
     " --no-pretty-names            do not simplify identifiers\n"
     " --graphml-witness filename   write the witness in GraphML format to filename\n" // NOLINT(*)
     "\n"
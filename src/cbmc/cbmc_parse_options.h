@@ -51,7 +51,9 @@ class optionst;
   "(error-label):(verbosity):(no-library)" \
   "(nondet-static)" \
   "(version)" \
-  "(cover):(symex-coverage-report):" \
+  "(cover):(cover-minimize)(symex-coverage-report):" \
+  "(k-induction):" \
+  "(check-contracts)(contract-cache):" \
   "(mm):" \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
   "(ppc-macos)(unsigned-char)" \
@@ -61,8 +63,9 @@ class optionst;
   "(graphml-witness):" \
   "(java-max-vla-length):(java-unwind-enum-static)" \
   "(java-cp-include-files):" \
+  "(java-method-cache):" \
   "(localize-faults)(localize-faults-method):" \
-  "(lazy-methods)" \
+  "(lazy-methods)(lazy-methods-context-sensitive)" \
   "(fixedbv)(floatbv)(all-claims)(all-properties)" // legacy, and will eventually disappear // NOLINT(whitespace/line_length)
 
 class cbmc_parse_optionst:
@@ -90,6 +93,14 @@ protected:
     bmct &bmc,
     const goto_functionst &goto_functions);
 
+  int do_k_induction(
+    const optionst &options,
+    const goto_functionst &goto_functions);
+
+  int do_check_contracts(
+    const optionst &options,
+    const goto_functionst &goto_functions);
+
   virtual int get_goto_program(
     const optionst &options,
     expr_listt &bmc_constraints,
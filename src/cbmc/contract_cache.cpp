@@ -0,0 +1,215 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Proved Function Contracts
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Proved Function Contracts
+
+#include "contract_cache.h"
+
+#include <fstream>
+
+#include <util/cprover_prefix.h>
+#include <util/irep_hash.h>
+#include <util/json.h>
+#include <util/string_hash.h>
+
+#include <json/json_parser.h>
+
+// bump this whenever the checks or the format of the file change
+static const char cache_version[]="3";
+
+contract_cachet::contract_cachet(
+  const goto_functionst &_goto_functions,
+  const namespacet &_ns,
+  const optionst &_options,
+  message_handlert &_message_handler):
+  messaget(_message_handler),
+  goto_functions(_goto_functions),
+  ns(_ns),
+  options(_options),
+  hits(0)
+{
+  compute_keys();
+}
+
+static bool has_contract(const goto_functionst::goto_functiont &function)
+{
+  return function.type.find(ID_C_spec_ensures).is_not_nil();
+}
+
+/// Calls to a function with a contract are replaced by the contract,
+/// hence only the function under test and those without a contract
+/// contribute their bodies
+class contract_dependenciest:public function_dependenciest
+{
+public:
+  contract_dependenciest(
+    const goto_functionst &_goto_functions,
+    const namespacet &_ns):
+    function_dependenciest(_goto_functions, _ns)
+  {
+  }
+
+protected:
+  bool follow_calls(
+    const irep_idt &root,
+    const irep_idt &function,
+    const goto_functionst::goto_functiont &goto_function) override
+  {
+    return function==root || !has_contract(goto_function);
+  }
+
+  std::size_t hash_function(
+    const goto_functionst::goto_functiont &goto_function,
+    bool calls_followed) override
+  {
+    std::size_t h=
+      function_dependenciest::hash_function(goto_function, calls_followed);
+
+    // contracts are comments, which content_hasht ignores
+    if(has_contract(goto_function))
+    {
+      h=hash_combine(
+        h, content_hash(goto_function.type.find(ID_C_spec_requires)));
+      h=hash_combine(
+        h, content_hash(goto_function.type.find(ID_C_spec_ensures)));
+    }
+
+    return h;
+  }
+};
+
+/// A proof only holds for the unwinding it was done with
+void contract_cachet::add_options(
+  function_dependenciest::hashest &dest) const
+{
+  // these names cannot clash with those of symbols
+  for(const auto &option : { "unwind", "unwindset", "depth" })
+    dest[std::string("--")+option]=hash_string(options.get_option(option));
+
+  for(const auto &option : { "unwinding-assertions", "partial-loops" })
+    dest[std::string("--")+option]=options.get_bool_option(option);
+}
+
+void contract_cachet::compute_keys()
+{
+  contract_dependenciest contract_dependencies(goto_functions, ns);
+
+  forall_goto_functions(f_it, goto_functions)
+    if(has_contract(f_it->second) ||
+       f_it->first==goto_functions.entry_point())
+    {
+      entryt &entry=current[f_it->first];
+      add_options(entry.dependencies);
+      contract_dependencies(f_it->first, entry.dependencies);
+
+      // the check runs after the initialization of the globals
+      contract_dependencies(CPROVER_PREFIX "initialize", entry.dependencies);
+      entry.key=function_dependenciest::digest(entry.dependencies);
+    }
+}
+
+bool contract_cachet::read(const std::string &file_name)
+{
+  std::ifstream in(file_name);
+
+  if(!in)
+  {
+    status() << "No cached proofs in `" << file_name << "'" << eom;
+    return false;
+  }
+
+  jsont json;
+
+  if(parse_json(in, file_name, get_message_handler(), json) ||
+     !json.is_object())
+  {
+    error() << "failed to read cached proofs from `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  if(json["version"].value!=cache_version)
+  {
+    warning() << "ignoring cached proofs of another version" << eom;
+    return false;
+  }
+
+  for(const auto &function : json["functions"].object)
+  {
+    entryt &entry=proofs[function.first];
+    entry.key=function.second["key"].value;
+
+    if(function_dependenciest::from_json(
+         function.second["dependencies"], entry.dependencies))
+    {
+      error() << "failed to read cached proofs from `"
+              << file_name << "'" << eom;
+      return true;
+    }
+  }
+
+  status() << "Read cached proofs of " << proofs.size()
+           << " contracts" << eom;
+
+  return false;
+}
+
+bool contract_cachet::write(const std::string &file_name)
+{
+  json_objectt json;
+  json["version"]=json_stringt(cache_version);
+  json_objectt &functions=json["functions"].make_object();
+
+  for(const auto &proof : proofs)
+  {
+    // drop functions that no longer exist
+    if(current.find(proof.first)==current.end())
+      continue;
+
+    json_objectt &function=functions[proof.first].make_object();
+    function["key"]=json_stringt(proof.second.key);
+    function["dependencies"]=
+      function_dependenciest::to_json(proof.second.dependencies);
+  }
+
+  std::ofstream out(file_name);
+
+  if(!out)
+  {
+    error() << "failed to write cached proofs to `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  out << json;
+
+  return false;
+}
+
+bool contract_cachet::is_proved(const irep_idt &function)
+{
+  std::map<irep_idt, entryt>::const_iterator c_it=current.find(function);
+  proofst::const_iterator p_it=proofs.find(id2string(function));
+
+  // the key only speeds up the comparison; the dependencies are compared
+  // one by one such that a collision cannot produce a wrong proof
+  if(c_it==current.end() ||
+     p_it==proofs.end() ||
+     p_it->second.key!=c_it->second.key ||
+     p_it->second.dependencies!=c_it->second.dependencies)
+    return false;
+
+  hits++;
+  return true;
+}
+
+void contract_cachet::insert_proof(const irep_idt &function)
+{
+  proofs[id2string(function)]=current[function];
+}
@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Proved Function Contracts
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Proved Function Contracts
+
+#ifndef CPROVER_CBMC_CONTRACT_CACHE_H
+#define CPROVER_CBMC_CONTRACT_CACHE_H
+
+#include <map>
+#include <string>
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/options.h>
+
+#include <goto-programs/function_dependencies.h>
+
+/// Remembers which function contracts have been proved across runs of
+/// cbmc. The proof of a contract depends on the body of the function, on
+/// the contracts of the functions it calls, and on the bodies of those it
+/// calls that have no contract, as well as on the options that bound the
+/// unwinding. A proof is only reused if none of these has changed.
+class contract_cachet:public messaget
+{
+public:
+  contract_cachet(
+    const goto_functionst &_goto_functions,
+    const namespacet &_ns,
+    const optionst &_options,
+    message_handlert &_message_handler);
+
+  /// \return true on error; a missing file is not an error
+  bool read(const std::string &file_name);
+
+  /// \return true on error
+  bool write(const std::string &file_name);
+
+  /// \return true if the contract of \p function has been proved before
+  ///   and nothing it depends on has changed since
+  bool is_proved(const irep_idt &function);
+
+  void insert_proof(const irep_idt &function);
+
+  std::size_t number_of_hits() const
+  {
+    return hits;
+  }
+
+protected:
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+  const optionst &options;
+
+  struct entryt
+  {
+    std::string key;
+    function_dependenciest::hashest dependencies;
+  };
+
+  // keyed on the function name
+  typedef std::map<std::string, entryt> proofst;
+  proofst proofs;
+
+  std::map<irep_idt, entryt> current;
+
+  std::size_t hits;
+
+  void compute_keys();
+  void add_options(function_dependenciest::hashest &dest) const;
+};
+
+#endif // CPROVER_CBMC_CONTRACT_CACHE_H
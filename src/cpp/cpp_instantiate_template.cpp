@@ -289,6 +289,16 @@ const symbolt &cpp_typecheckt::instantiate_template(
   INVARIANT_STRUCTURED(
     template_scope!=nullptr, nullptr_exceptiont, "template_scope is null");
 
+  // sub-scope for fixing the prefix
+  std::string subscope_name=id2string(template_scope->identifier)+suffix;
+
+  // the common case: we have a complete instance already
+  template_instancest::const_iterator instance_it=
+    template_instances.find(subscope_name);
+
+  if(instance_it!=template_instances.end())
+    return lookup(instance_it->second);
+
   // produce new declaration
   cpp_declarationt new_decl=to_cpp_declaration(template_symbol.type);
 
@@ -320,9 +330,6 @@ const symbolt &cpp_typecheckt::instantiate_template(
   if(is_template_method)
     class_name=cpp_scopes.current_scope().get_parent().identifier;
 
-  // sub-scope for fixing the prefix
-  std::string subscope_name=id2string(template_scope->identifier)+suffix;
-
   // let's see if we have the instance already
   cpp_scopest::id_mapt::iterator scope_it=
     cpp_scopes.id_map.find(subscope_name);
@@ -345,11 +352,13 @@ const symbolt &cpp_typecheckt::instantiate_template(
       const symbolt &symb=lookup(cpp_id.identifier);
 
       // continue if the type is incomplete only
-      if(cpp_id.id_class==cpp_idt::id_classt::CLASS &&
-         symb.type.id()==ID_struct)
-        return symb;
-      else if(symb.value.is_not_nil())
+      if((cpp_id.id_class==cpp_idt::id_classt::CLASS &&
+          symb.type.id()==ID_struct) ||
+         symb.value.is_not_nil())
+      {
+        template_instances[subscope_name]=symb.name;
         return symb;
+      }
     }
 
     cpp_scopes.go_to(scope);
@@ -446,6 +455,9 @@ const symbolt &cpp_typecheckt::instantiate_template(
     const symbolt &new_symb=
       lookup(new_decl.type().get(ID_identifier));
 
+    if(new_symb.type.id()==ID_struct)
+      template_instances[subscope_name]=new_symb.name;
+
     return new_symb;
   }
 
@@ -21,7 +21,8 @@ class cpp_tokent
 public:
   int kind;
   exprt data;
-  std::string text;
+  // interned, as tokens are copied a lot during backtracking
+  irep_idt text;
   unsigned line_no;
   irep_idt filename;
 
@@ -29,7 +30,7 @@ public:
   {
     kind=0;
     data.clear();
-    text="";
+    text.clear();
     line_no=0;
     filename="";
   }
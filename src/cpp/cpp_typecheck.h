@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include <set>
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include <util/std_code.h>
 #include <util/std_types.h>
@@ -184,6 +185,12 @@ protected:
 
   void show_instantiation_stack(std::ostream &);
 
+  // Complete instances of templates, keyed on the name of the template
+  // followed by the suffix of the arguments. This avoids setting up the
+  // scopes and the template map just to find an existing instance.
+  typedef std::unordered_map<std::string, irep_idt> template_instancest;
+  template_instancest template_instances;
+
   class instantiation_levelt
   {
   public:
@@ -503,7 +503,7 @@ bool Parser::SyntaxError()
       {
         if(i!=0)
           message+=' ';
-        message+=t[i].text;
+        message+=id2string(t[i].text);
       }
 
     message+="'";
@@ -3743,7 +3743,7 @@ bool Parser::rTemplateArgs(irept &template_args)
     case TOK_SHIFTRIGHT: // turn >> into > >
       lex.Restore(pos);
       tk2.kind='>';
-      tk2.text='>';
+      tk2.text=">";
       lex.Replace(tk2);
       lex.Insert(tk2);
       assert(lex.LookAhead(0)=='>');
@@ -6360,7 +6360,7 @@ bool Parser::rTypePredicate(exprt &expr)
 
   lex.get_token(tk);
 
-  expr.id(irep_idt(tk.text));
+  expr.id(tk.text);
   set_location(expr, tk);
 
   typet tname1, tname2;
@@ -297,6 +297,7 @@ int goto_analyzer_parse_optionst::doit()
     optionst options;
     options.set_option("json", cmdline.get_value("json"));
     options.set_option("xml", cmdline.get_value("xml"));
+    options.set_option("result-cache", cmdline.get_value("result-cache"));
     bool result=
       static_analyzer(goto_model, options, get_message_handler());
     return result?10:0;
@@ -458,6 +459,8 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --json file_name             output results in JSON format to given file\n"
     " --xml file_name              output results in XML format to given file\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --result-cache file_name     reuse the results of unchanged functions stored in given file\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -0,0 +1,159 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Static Analysis Results
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Static Analysis Results
+
+#include "static_analysis_cache.h"
+
+#include <fstream>
+
+#include <util/json.h>
+
+#include <json/json_parser.h>
+
+// bump this whenever the analysis or the format of the file changes
+static const char cache_version[]="3";
+
+static_analysis_cachet::static_analysis_cachet(
+  const goto_functionst &_goto_functions,
+  const namespacet &_ns,
+  message_handlert &_message_handler):
+  messaget(_message_handler),
+  hits(0),
+  misses(0)
+{
+  function_dependenciest function_dependencies(_goto_functions, _ns);
+
+  // everything the analysis from the entry point depends on
+  function_dependencies(_goto_functions.entry_point(), dependencies);
+
+  // the assertions of unreachable functions have verdicts, too
+  forall_goto_functions(f_it, _goto_functions)
+    if(f_it->second.body.has_assertion())
+      function_dependencies(f_it->first, dependencies);
+
+  key=function_dependenciest::digest(dependencies);
+}
+
+bool static_analysis_cachet::read(const std::string &file_name)
+{
+  std::ifstream in(file_name);
+
+  if(!in)
+  {
+    status() << "No cached results in `" << file_name << "'" << eom;
+    return false;
+  }
+
+  jsont json;
+
+  if(parse_json(in, file_name, get_message_handler(), json) ||
+     !json.is_object() ||
+     !json["functions"].is_object())
+  {
+    error() << "failed to read cached results from `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  if(json["version"].value!=cache_version)
+  {
+    warning() << "ignoring cached results of another version" << eom;
+    return false;
+  }
+
+  entry.key=json["key"].value;
+
+  if(function_dependenciest::from_json(
+       json["dependencies"], entry.dependencies))
+  {
+    error() << "failed to read cached results from `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  for(const auto &function : json["functions"].object)
+  {
+    std::vector<tvt> &function_results=entry.results[function.first];
+
+    for(const auto &result : function.second.array)
+    {
+      if(result.value=="TRUE")
+        function_results.push_back(tvt(true));
+      else if(result.value=="FALSE")
+        function_results.push_back(tvt(false));
+      else
+        function_results.push_back(tvt::unknown());
+    }
+  }
+
+  entry.valid=true;
+
+  status() << "Read cached results of " << entry.results.size()
+           << " functions" << eom;
+
+  return false;
+}
+
+bool static_analysis_cachet::write(const std::string &file_name)
+{
+  if(!entry.valid)
+    return false;
+
+  json_objectt json;
+  json["version"]=json_stringt(cache_version);
+  json["key"]=json_stringt(entry.key);
+  json["dependencies"]=function_dependenciest::to_json(entry.dependencies);
+  json_objectt &functions=json["functions"].make_object();
+
+  for(const auto &function : entry.results)
+  {
+    json_arrayt &results=functions[id2string(function.first)].make_array();
+
+    for(const auto &result : function.second)
+      results.push_back(json_stringt(result.to_string()));
+  }
+
+  std::ofstream out(file_name);
+
+  if(!out)
+  {
+    error() << "failed to write cached results to `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  out << json;
+
+  return false;
+}
+
+const static_analysis_cachet::resultst *static_analysis_cachet::find()
+{
+  // the key only speeds up the comparison; the dependencies are compared
+  // one by one such that a collision cannot produce a wrong verdict
+  if(!entry.valid ||
+     entry.key!=key ||
+     entry.dependencies!=dependencies)
+  {
+    misses++;
+    return nullptr;
+  }
+
+  hits++;
+  return &entry.results;
+}
+
+void static_analysis_cachet::insert(const resultst &results)
+{
+  entry.valid=true;
+  entry.key=key;
+  entry.dependencies=dependencies;
+  entry.results=results;
+}
@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Static Analysis Results
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Static Analysis Results
+
+#ifndef CPROVER_GOTO_ANALYZER_STATIC_ANALYSIS_CACHE_H
+#define CPROVER_GOTO_ANALYZER_STATIC_ANALYSIS_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/threeval.h>
+
+#include <goto-programs/function_dependencies.h>
+#include <goto-programs/goto_functions.h>
+
+/// Stores the verdicts of the assertions of a program across runs of
+/// goto-analyzer. The whole program is analysed at once, hence the
+/// verdicts depend on everything reachable from the entry point, which
+/// includes the initial values of the globals. They are only reused if
+/// none of these dependencies, nor any function with assertions, has
+/// changed.
+class static_analysis_cachet:public messaget
+{
+public:
+  static_analysis_cachet(
+    const goto_functionst &_goto_functions,
+    const namespacet &_ns,
+    message_handlert &_message_handler);
+
+  // verdicts of the assertions of each function, in program order
+  typedef std::map<irep_idt, std::vector<tvt> > resultst;
+
+  /// \return true on error; a missing file is not an error
+  bool read(const std::string &file_name);
+
+  /// \return true on error
+  bool write(const std::string &file_name);
+
+  /// \return the results of the program, or nullptr if they are not
+  ///   cached or out of date
+  const resultst *find();
+
+  void insert(const resultst &results);
+
+  std::size_t number_of_hits() const
+  {
+    return hits;
+  }
+
+  std::size_t number_of_misses() const
+  {
+    return misses;
+  }
+
+protected:
+  function_dependenciest::hashest dependencies;
+  std::string key;
+
+  struct entryt
+  {
+    entryt():valid(false)
+    {
+    }
+
+    bool valid;
+    std::string key;
+    function_dependenciest::hashest dependencies;
+    resultst results;
+  };
+
+  entryt entry;
+
+  std::size_t hits;
+  std::size_t misses;
+};
+
+#endif // CPROVER_GOTO_ANALYZER_STATIC_ANALYSIS_CACHE_H
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "static_analyzer.h"
 
 #include <fstream>
+#include <memory>
 
 #include <util/threeval.h>
 #include <util/json.h>
@@ -16,6 +17,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/interval_domain.h>
 
+#include "static_analysis_cache.h"
+
 class static_analyzert:public messaget
 {
 public:
@@ -40,6 +43,12 @@ protected:
   // analyses
   ait<interval_domaint> interval_analysis;
 
+  // verdicts of the assertions of each function, in program order
+  typedef static_analysis_cachet::resultst resultst;
+  resultst results;
+
+  void compute_results(static_analysis_cachet *cache);
+
   void plain_text_report();
   void json_report(const std::string &);
   void xml_report(const std::string &);
@@ -49,8 +58,29 @@ protected:
 
 bool static_analyzert::operator()()
 {
-  status() << "performing interval analysis" << eom;
-  interval_analysis(goto_functions, ns);
+  const std::string cache_file=options.get_option("result-cache");
+  std::unique_ptr<static_analysis_cachet> cache;
+
+  if(!cache_file.empty())
+  {
+    cache=std::unique_ptr<static_analysis_cachet>(
+      new static_analysis_cachet(goto_functions, ns, get_message_handler()));
+
+    if(cache->read(cache_file))
+      return true;
+  }
+
+  compute_results(cache.get());
+
+  if(cache)
+  {
+    statistics() << "Cached results: " << cache->number_of_hits()
+                 << " hits, " << cache->number_of_misses() << " misses"
+                 << eom;
+
+    if(cache->write(cache_file))
+      return true;
+  }
 
   if(!options.get_option("json").empty())
     json_report(options.get_option("json"));
@@ -62,6 +92,43 @@ bool static_analyzert::operator()()
   return false;
 }
 
+/// Computes the verdicts of all assertions, or takes them from the
+/// \p cache if the program has not changed
+void static_analyzert::compute_results(static_analysis_cachet *cache)
+{
+  if(cache!=nullptr)
+  {
+    const resultst *cached=cache->find();
+
+    if(cached!=nullptr)
+    {
+      results=*cached;
+      return;
+    }
+  }
+
+  status() << "performing interval analysis" << eom;
+  interval_analysis(goto_functions, ns);
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body.has_assertion())
+      continue;
+
+    if(f_it->first=="__actual_thread_spawn")
+      continue;
+
+    std::vector<tvt> &function_results=results[f_it->first];
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      if(i_it->is_assert())
+        function_results.push_back(eval(i_it));
+  }
+
+  if(cache!=nullptr)
+    cache->insert(results);
+}
+
 tvt static_analyzert::eval(goto_programt::const_targett t)
 {
   exprt guard=t->guard;
@@ -86,12 +153,15 @@ void static_analyzert::plain_text_report()
 
     status() << "******** Function " << f_it->first << eom;
 
+    const std::vector<tvt> &function_results=results[f_it->first];
+    std::size_t index=0;
+
     forall_goto_program_instructions(i_it, f_it->second.body)
     {
       if(!i_it->is_assert())
         continue;
 
-      tvt r=eval(i_it);
+      tvt r=function_results[index++];
 
       result() << '[' << i_it->source_location.get_property_id()
                << ']' << ' ';
@@ -135,12 +205,15 @@ void static_analyzert::json_report(const std::string &file_name)
     if(f_it->first=="__actual_thread_spawn")
       continue;
 
+    const std::vector<tvt> &function_results=results[f_it->first];
+    std::size_t index=0;
+
     forall_goto_program_instructions(i_it, f_it->second.body)
     {
       if(!i_it->is_assert())
         continue;
 
-      tvt r=eval(i_it);
+      tvt r=function_results[index++];
 
       json_objectt &j=json_result.push_back().make_object();
 
@@ -182,12 +255,15 @@ void static_analyzert::xml_report(const std::string &file_name)
     if(f_it->first=="__actual_thread_spawn")
       continue;
 
+    const std::vector<tvt> &function_results=results[f_it->first];
+    std::size_t index=0;
+
     forall_goto_program_instructions(i_it, f_it->second.body)
     {
       if(!i_it->is_assert())
         continue;
 
-      tvt r=eval(i_it);
+      tvt r=function_results[index++];
 
       xmlt &x=xml_result.new_element("result");
 
@@ -18,6 +18,7 @@ Date: June 2006
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <set>
 
 #include <util/config.h>
 #include <util/tempdir.h>
@@ -49,7 +50,7 @@ Date: June 2006
                           "size=\"30,40\";"\
                           "ratio=compress;"
 
-// the following are for chdir
+// the following are for chdir and fork
 
 #if defined(__linux__) || \
     defined(__FreeBSD_kernel__) || \
@@ -58,6 +59,10 @@ Date: June 2006
     defined(__CYGWIN__) || \
     defined(__MACH__)
 #include <unistd.h>
+#include <sys/wait.h>
+#include <cerrno>
+#include <cstring>
+#define GOTO_CC_FORK
 #endif
 
 #ifdef _WIN32
@@ -387,55 +392,214 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+  if(jobs>1 &&
+     source_files.size()>1 &&
+     mode!=PREPROCESS_ONLY)
+    return compile_in_parallel();
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
     source_files.pop_front();
 
-    // Visual Studio always prints the name of the file it's doing
-    if(echo_file_name)
-      status() << file_name << eom;
+    if(compile_source(file_name))
+      return true;
+
+    if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+    {
+      // output an object file for every source file
+      if(write_unit(object_file_name(file_name)))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+/// parses and type checks a single source file into the symbol table
+/// \return true on error, false otherwise
+bool compilet::compile_source(const std::string &file_name)
+{
+  // Visual Studio always prints the name of the file it's doing
+  if(echo_file_name)
+    status() << file_name << eom;
 
-    bool r=parse_source(file_name); // don't break the program!
+  bool r=parse_source(file_name); // don't break the program!
 
-    if(r)
+  if(r)
+  {
+    const std::string &debug_outfile=
+      cmdline.get_value("print-rejected-preprocessed-source");
+    if(!debug_outfile.empty())
     {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
-      {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
-      }
+      std::ifstream in(file_name, std::ios::binary);
+      std::ofstream out(debug_outfile, std::ios::binary);
+      out << in.rdbuf();
+      warning() << "Failed sources in " << debug_outfile << eom;
+    }
+
+    return true; // parser/typecheck error
+  }
+
+  return false;
+}
+
+/// "compiles" the functions in the symbol table, writes them to an object
+/// file, and clears the symbol table for the next source file
+/// \return true on error, false otherwise
+bool compilet::write_unit(const std::string &file_name)
+{
+  convert_symbols(compiled_functions);
+
+  if(write_object_file(file_name, symbol_table, compiled_functions))
+    return true;
+
+  symbol_table.clear(); // clean symbol table for next source file.
+  compiled_functions.clear();
+
+  return false;
+}
+
+std::string compilet::object_file_name(const std::string &file_name) const
+{
+  if(output_file_object=="")
+    return get_base_name(file_name, true)+"."+object_file_extension;
+  else
+    return output_file_object;
+}
+
+/// compiles the source files in separate processes, running up to `jobs`
+/// of them at a time. Each process writes an object file; when linking,
+/// these are temporary, and are linked in the order of the source files,
+/// which makes the result independent of the order the processes finish in.
+/// \return true on error, false otherwise
+bool compilet::compile_in_parallel()
+{
+  const bool link_after=mode!=COMPILE_ONLY && mode!=ASSEMBLE_ONLY;
+
+#ifdef GOTO_CC_FORK
+  // all object files would go to the same file
+  if(!link_after && output_file_object!="")
+  {
+    jobs=1;
+    return compile();
+  }
+
+  const std::vector<std::string> files(
+    source_files.begin(), source_files.end());
+  source_files.clear();
 
-      return true; // parser/typecheck error
+  std::vector<std::string> unit_objects;
+
+  if(link_after)
+  {
+    char td[] = "goto-cc.XXXXXX";
+    std::string tstr=get_temporary_directory(td);
+
+    if(tstr=="")
+    {
+      error() << "Cannot create temporary directory" << eom;
+      return true;
     }
 
-    if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+    tmp_dirs.push_back(tstr);
+
+    for(std::size_t i=0; i<files.size(); i++)
+      unit_objects.push_back(tstr+"/"+std::to_string(i)+".gb");
+  }
+  else
+  {
+    for(const auto &file_name : files)
+      unit_objects.push_back(object_file_name(file_name));
+  }
+
+  // flush what's buffered such that the children don't print it again
+  std::cout.flush();
+  std::cerr.flush();
+
+  std::set<pid_t> children;
+  std::size_t next=0;
+  bool error_found=false;
+
+  while(!children.empty() ||
+        (!error_found && next<files.size()))
+  {
+    if(!error_found &&
+       next<files.size() &&
+       children.size()<jobs)
     {
-      // output an object file for every source file
+      pid_t pid=fork();
 
-      // "compile" functions
-      convert_symbols(compiled_functions);
+      if(pid==-1)
+      {
+        error() << "failed to fork: " << std::strerror(errno) << eom;
+        error_found=true;
+        continue;
+      }
 
-      std::string cfn;
+      if(pid==0)
+      {
+        // child: we have our own copy of the symbol table
+        const unsigned warnings_before=
+          get_message_handler().get_message_count(messaget::M_WARNING);
 
-      if(output_file_object=="")
-        cfn=get_base_name(file_name, true)+"."+object_file_extension;
-      else
-        cfn=output_file_object;
+        bool result=
+          compile_source(files[next]) ||
+          write_unit(unit_objects[next]);
 
-      if(write_object_file(cfn, symbol_table, compiled_functions))
-        return true;
+        if(warning_is_fatal &&
+           get_message_handler().get_message_count(messaget::M_WARNING)!=
+           warnings_before)
+          result=true;
 
-      symbol_table.clear(); // clean symbol table for next source file.
-      compiled_functions.clear();
+        std::cout.flush();
+        std::cerr.flush();
+
+        // don't run the destructors, which would delete the
+        // temporary directories of the parent
+        _exit(result?1:0);
+      }
+
+      children.insert(pid);
+      next++;
+      continue;
     }
+
+    int status;
+    pid_t pid=waitpid(-1, &status, 0);
+
+    if(pid==-1)
+    {
+      if(errno==EINTR)
+        continue;
+
+      error() << "failed to wait for child: " << std::strerror(errno) << eom;
+      return true;
+    }
+
+    if(children.erase(pid)==0)
+      continue;
+
+    if(!WIFEXITED(status) || WEXITSTATUS(status)!=0)
+      error_found=true;
   }
 
+  if(error_found)
+    return true;
+
+  // the linker merges the units in the order of the source files
+  if(link_after)
+    object_files.insert(
+      object_files.begin(), unit_objects.begin(), unit_objects.end());
+
   return false;
+#else
+  (void)link_after;
+  warning() << "parallel compilation is not supported on this platform"
+            << eom;
+  jobs=1;
+  return compile();
+#endif
 }
 
 /// parses a source file (low-level parsing)
@@ -651,6 +815,7 @@ compilet::compilet(cmdlinet &_cmdline, ui_message_handlert &mh, bool Werror):
 {
   mode=COMPILE_LINK_EXECUTABLE;
   echo_file_name=false;
+  jobs=1;
   working_directory=get_current_working_directory();
 }
 
@@ -29,6 +29,9 @@ public:
   std::string working_directory;
   std::string override_language;
 
+  // number of source files compiled in parallel
+  unsigned jobs;
+
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
          ASSEMBLE_ONLY, // gcc -S
@@ -62,6 +65,8 @@ public:
   bool link();
 
   bool parse_source(const std::string &);
+  bool compile_source(const std::string &);
+  bool write_unit(const std::string &);
 
   bool write_object_file(
     const std::string &,
@@ -78,6 +83,9 @@ protected:
 
   unsigned function_body_count(const goto_functionst &);
 
+  std::string object_file_name(const std::string &) const;
+  bool compile_in_parallel();
+
   void add_compiler_specific_defines(class configt &config) const;
 
   void convert_symbols(goto_functionst &dest);
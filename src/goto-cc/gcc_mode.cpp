@@ -546,6 +546,9 @@ int gcc_modet::doit()
   else
     compiler.object_file_extension="o";
 
+  if(cmdline.isset("jobs"))
+    compiler.jobs=unsafe_string2unsigned(cmdline.get_value("jobs"));
+
   if(cmdline.isset("std"))
   {
     std::string std_string=cmdline.get_value("std");
@@ -18,11 +18,15 @@ Author: Matt Lewis
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
 #include <util/find_symbols.h>
+#include <util/replace_symbol.h>
 
 #include <ansi-c/expr2c.h>
 
+#include <algorithm>
 #include <iostream>
 #include <list>
+#include <map>
+#include <set>
 
 #include "path.h"
 #include "polynomial_accelerator.h"
@@ -86,6 +90,240 @@ bool acceleratet::contains_nested_loops(goto_programt::targett &loop_header)
   return false;
 }
 
+/// Collects the symbols introduced by acceleration in \p expr, in order
+/// of first occurrence
+static void find_acceleration_symbols(
+  const exprt &expr,
+  const namespacet &ns,
+  std::set<irep_idt> &seen,
+  std::vector<symbol_exprt> &dest)
+{
+  if(expr.id()==ID_symbol)
+  {
+    const symbol_exprt &symbol_expr=to_symbol_expr(expr);
+    const symbolt *symbol;
+
+    if(seen.insert(symbol_expr.get_identifier()).second &&
+       !ns.lookup(symbol_expr.get_identifier(), symbol) &&
+       symbol->module=="scratch")
+      dest.push_back(symbol_expr);
+  }
+
+  forall_operands(it, expr)
+    find_acceleration_symbols(*it, ns, seen, dest);
+}
+
+static void find_acceleration_symbols(
+  const goto_programt &program,
+  const namespacet &ns,
+  std::set<irep_idt> &seen,
+  std::vector<symbol_exprt> &dest)
+{
+  forall_goto_program_instructions(it, program)
+  {
+    find_acceleration_symbols(it->code, ns, seen, dest);
+    find_acceleration_symbols(it->guard, ns, seen, dest);
+  }
+}
+
+static void rename_symbols(
+  const replace_symbolt &rename,
+  goto_programt &program)
+{
+  Forall_goto_program_instructions(it, program)
+  {
+    rename(it->code);
+    rename(it->guard);
+  }
+}
+
+static void rename_symbols(
+  const replace_symbolt &rename,
+  std::set<exprt> &exprs)
+{
+  std::set<exprt> renamed;
+
+  for(exprt e : exprs)
+  {
+    rename(e);
+    renamed.insert(e);
+  }
+
+  exprs.swap(renamed);
+}
+
+/// \return a key for the cache of accelerators: the instructions of
+///   \p loop in program order, with the symbols introduced by acceleration
+///   renamed by order of first occurrence and the targets of jumps
+///   replaced by their position in the loop
+irept acceleratet::normalize_loop(
+  natural_loops_mutablet::natural_loopt &loop,
+  loop_instructionst &loop_instructions,
+  std::vector<symbol_exprt> &loop_symbols)
+{
+  loop_instructions.assign(loop.begin(), loop.end());
+  std::sort(
+    loop_instructions.begin(),
+    loop_instructions.end(),
+    [](goto_programt::targett a, goto_programt::targett b)
+    {
+      return a->location_number<b->location_number;
+    });
+
+  std::map<goto_programt::targett, std::size_t> index;
+  std::set<irep_idt> seen;
+
+  for(const auto &t : loop_instructions)
+  {
+    index.insert(std::make_pair(t, index.size()));
+    find_acceleration_symbols(t->code, ns, seen, loop_symbols);
+    find_acceleration_symbols(t->guard, ns, seen, loop_symbols);
+  }
+
+  replace_symbolt rename;
+
+  for(std::size_t i=0; i<loop_symbols.size(); i++)
+    rename.insert(
+      loop_symbols[i].get_identifier(),
+      symbol_exprt(
+        "accelerate::normalized_"+std::to_string(i),
+        loop_symbols[i].type()));
+
+  irept key;
+
+  for(const auto &t : loop_instructions)
+  {
+    irept instruction(std::to_string(t->type));
+
+    exprt code=t->code;
+    rename(code);
+    instruction.set(ID_code, code);
+
+    exprt guard=t->guard;
+    rename(guard);
+    instruction.set(ID_guard, guard);
+
+    irept &targets=instruction.add(ID_targets);
+
+    for(const auto &target : t->targets)
+    {
+      std::map<goto_programt::targett, std::size_t>::const_iterator i_it=
+        index.find(target);
+
+      targets.get_sub().push_back(
+        irept(i_it==index.end()?"exit":std::to_string(i_it->second)));
+    }
+
+    key.get_sub().push_back(instruction);
+  }
+
+  return key;
+}
+
+void acceleratet::cache_accelerators(
+  const irept &key,
+  const loop_instructionst &loop_instructions,
+  const std::vector<symbol_exprt> &loop_symbols,
+  const std::list<path_acceleratort> &accelerators)
+{
+  std::map<goto_programt::targett, std::size_t> index;
+
+  for(const auto &t : loop_instructions)
+    index.insert(std::make_pair(t, index.size()));
+
+  acceleration_cachet::entryt entry;
+  entry.loop_symbols=loop_symbols;
+
+  std::set<irep_idt> seen;
+
+  for(const auto &symbol : loop_symbols)
+    seen.insert(symbol.get_identifier());
+
+  for(const auto &accelerator : accelerators)
+  {
+    entry.accelerators.push_back(
+      acceleration_cachet::cached_acceleratort(accelerator));
+    acceleration_cachet::cached_acceleratort &cached=
+      entry.accelerators.back();
+
+    for(const auto &node : accelerator.path)
+    {
+      std::map<goto_programt::targett, std::size_t>::const_iterator i_it=
+        index.find(node.loc);
+
+      // the path leaves the loop as it was when normalized
+      if(i_it==index.end())
+        return;
+
+      cached.path.push_back(std::make_pair(i_it->second, node.guard));
+
+      find_acceleration_symbols(
+        node.guard, ns, seen, entry.accelerator_symbols);
+    }
+
+    find_acceleration_symbols(
+      accelerator.pure_accelerator, ns, seen, entry.accelerator_symbols);
+    find_acceleration_symbols(
+      accelerator.overflow_path, ns, seen, entry.accelerator_symbols);
+
+    for(const auto &e : accelerator.changed_vars)
+      find_acceleration_symbols(e, ns, seen, entry.accelerator_symbols);
+
+    for(const auto &e : accelerator.dirty_vars)
+      find_acceleration_symbols(e, ns, seen, entry.accelerator_symbols);
+  }
+
+  cache->entries.insert(std::make_pair(key, std::move(entry)));
+}
+
+/// Instantiates the cached accelerators of an identical loop for the
+/// loop given by \p loop_instructions. The symbols introduced for the
+/// cached loop are replaced by those of this loop, and the symbols that
+/// only occur in the accelerators by fresh ones.
+void acceleratet::reuse_accelerators(
+  const acceleration_cachet::entryt &entry,
+  const loop_instructionst &loop_instructions,
+  const std::vector<symbol_exprt> &loop_symbols,
+  std::list<path_acceleratort> &accelerators)
+{
+  replace_symbolt rename;
+
+  assert(entry.loop_symbols.size()==loop_symbols.size());
+
+  for(std::size_t i=0; i<loop_symbols.size(); i++)
+    rename.insert(entry.loop_symbols[i].get_identifier(), loop_symbols[i]);
+
+  for(const auto &symbol : entry.accelerator_symbols)
+  {
+    // fresh symbols are named base_N
+    const std::string &name=id2string(symbol.get_identifier());
+    const std::string base=name.substr(0, name.rfind('_'));
+
+    rename.insert(
+      symbol.get_identifier(),
+      utils.fresh_symbol(base, symbol.type()).symbol_expr());
+  }
+
+  for(const auto &cached : entry.accelerators)
+  {
+    accelerators.push_back(cached.accelerator);
+    path_acceleratort &accelerator=accelerators.back();
+
+    rename_symbols(rename, accelerator.pure_accelerator);
+    rename_symbols(rename, accelerator.overflow_path);
+    rename_symbols(rename, accelerator.changed_vars);
+    rename_symbols(rename, accelerator.dirty_vars);
+
+    for(const auto &node : cached.path)
+    {
+      exprt guard=node.second;
+      rename(guard);
+      accelerator.path.push_back(
+        path_nodet(loop_instructions[node.first], guard));
+    }
+  }
+}
+
 int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
 {
   pathst loop_paths, exit_paths;
@@ -108,49 +346,80 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
   make_overflow_loc(loop_header, back_jump, overflow_loc);
   program.update();
 
+  loop_instructionst loop_instructions;
+  std::vector<symbol_exprt> loop_symbols;
+  irept key;
+  const acceleration_cachet::entryt *cached=nullptr;
+
+  if(cache!=nullptr)
+  {
+    key=normalize_loop(loop, loop_instructions, loop_symbols);
+
+    acceleration_cachet::entriest::const_iterator entry=
+      cache->entries.find(key);
+
+    if(entry!=cache->entries.end())
+      cached=&entry->second;
+  }
+
+  if(cached!=nullptr)
+  {
+    // an identical loop has been accelerated already
+    reuse_accelerators(
+      *cached, loop_instructions, loop_symbols, accelerators);
+    num_accelerated=accelerators.size();
+    cache->hits++;
+  }
+  else
+  {
 #if 1
-  enumerating_loop_accelerationt
-    acceleration(
-      symbol_table,
-      goto_functions,
-      program,
-      loop,
-      loop_header,
-      accelerate_limit);
+    enumerating_loop_accelerationt
+      acceleration(
+        symbol_table,
+        goto_functions,
+        program,
+        loop,
+        loop_header,
+        accelerate_limit);
 #else
-  disjunctive_polynomial_accelerationt
-    acceleration(symbol_table, goto_functions, program, loop, loop_header);
+    disjunctive_polynomial_accelerationt
+      acceleration(symbol_table, goto_functions, program, loop, loop_header);
 #endif
 
-  path_acceleratort accelerator;
+    path_acceleratort accelerator;
 
-  while(acceleration.accelerate(accelerator) &&
-        (accelerate_limit < 0 ||
-         num_accelerated < accelerate_limit))
-  {
-    // set_dirty_vars(accelerator);
-
-    if(is_underapproximate(accelerator))
+    while(acceleration.accelerate(accelerator) &&
+          (accelerate_limit < 0 ||
+           num_accelerated < accelerate_limit))
     {
-      // We have some underapproximated variables -- just punt for now.
+      // set_dirty_vars(accelerator);
+
+      if(is_underapproximate(accelerator))
+      {
+        // We have some underapproximated variables -- just punt for now.
 #ifdef DEBUG
-      std::cout << "Not inserting accelerator because of underapproximation\n";
+        std::cout << "Not inserting accelerator because of "
+                  << "underapproximation\n";
 #endif
 
-      continue;
-    }
+        continue;
+      }
 
-    accelerators.push_back(accelerator);
-    num_accelerated++;
+      accelerators.push_back(accelerator);
+      num_accelerated++;
 
 #ifdef DEBUG
-    std::cout << "Accelerated path:\n";
-    output_path(accelerator.path, program, ns, std::cout);
+      std::cout << "Accelerated path:\n";
+      output_path(accelerator.path, program, ns, std::cout);
 
-    std::cout << "Accelerator has "
-              << accelerator.pure_accelerator.instructions.size()
-              << " instructions\n";
+      std::cout << "Accelerator has "
+                << accelerator.pure_accelerator.instructions.size()
+                << " instructions\n";
 #endif
+    }
+
+    if(cache!=nullptr)
+      cache_accelerators(key, loop_instructions, loop_symbols, accelerators);
   }
 
   goto_programt::instructiont skip(SKIP);
@@ -654,10 +923,14 @@ void accelerate_functions(
   symbol_tablet &symbol_table,
   bool use_z3)
 {
+  // shared by all functions, for the benefit of inlined code
+  acceleration_cachet cache;
+
   Forall_goto_functions(it, functions)
   {
     std::cout << "Accelerating function " << it->first << '\n';
-    acceleratet accelerate(it->second.body, functions, symbol_table, use_z3);
+    acceleratet accelerate(
+      it->second.body, functions, symbol_table, use_z3, &cache);
 
     int num_accelerated=accelerate.accelerate_loops();
 
@@ -667,4 +940,8 @@ void accelerate_functions(
                 << " accelerator(s)\n";
     }
   }
+
+  if(cache.hits>0)
+    std::cout << "Reused the accelerators of " << cache.hits
+              << " identical loop(s)\n";
 }
@@ -12,8 +12,14 @@ Author: Matt Lewis
 #ifndef CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATE_H
 #define CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATE_H
 
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 #include <util/namespace.h>
 #include <util/expr.h>
+#include <util/irep_hash.h>
+#include <util/std_expr.h>
 
 #include <analyses/natural_loops.h>
 
@@ -26,19 +32,66 @@ Author: Matt Lewis
 #include "scratch_program.h"
 #include "acceleration_utils.h"
 
+/// The accelerators of the loops accelerated so far. Loops are keyed on
+/// their instructions, with the symbols introduced by acceleration
+/// (e.g., the overflow flag) renamed by order of first occurrence, such
+/// that identical loops, e.g., of an inlined function, are accelerated
+/// only once.
+class acceleration_cachet
+{
+public:
+  acceleration_cachet():hits(0)
+  {
+  }
+
+  struct cached_acceleratort
+  {
+    explicit cached_acceleratort(const path_acceleratort &_accelerator):
+      accelerator(_accelerator)
+    {
+      accelerator.path.clear();
+    }
+
+    // with an empty path
+    path_acceleratort accelerator;
+
+    // the path, as indices into the instructions of the loop
+    std::vector<std::pair<std::size_t, exprt>> path;
+  };
+
+  struct entryt
+  {
+    // the symbols introduced by acceleration that occur in the loop,
+    // in order of first occurrence
+    std::vector<symbol_exprt> loop_symbols;
+
+    // those that occur in the accelerators only
+    std::vector<symbol_exprt> accelerator_symbols;
+
+    std::list<cached_acceleratort> accelerators;
+  };
+
+  typedef std::unordered_map<irept, entryt, irep_hash> entriest;
+  entriest entries;
+
+  std::size_t hits;
+};
+
 class acceleratet
 {
  public:
   acceleratet(goto_programt &_program,
               goto_functionst &_goto_functions,
               symbol_tablet &_symbol_table,
-              bool _use_z3) :
+              bool _use_z3,
+              acceleration_cachet *_cache=nullptr) :
       program(_program),
       goto_functions(_goto_functions),
       symbol_table(_symbol_table),
       ns(symbol_table),
       utils(symbol_table, goto_functions),
-      use_z3(_use_z3)
+      use_z3(_use_z3),
+      cache(_cache)
   {
     natural_loops(program);
   }
@@ -99,6 +152,25 @@ class acceleratet
 
   bool contains_nested_loops(goto_programt::targett &loop_header);
 
+  typedef std::vector<goto_programt::targett> loop_instructionst;
+
+  irept normalize_loop(
+    natural_loops_mutablet::natural_loopt &loop,
+    loop_instructionst &loop_instructions,
+    std::vector<symbol_exprt> &loop_symbols);
+
+  void cache_accelerators(
+    const irept &key,
+    const loop_instructionst &loop_instructions,
+    const std::vector<symbol_exprt> &loop_symbols,
+    const std::list<path_acceleratort> &accelerators);
+
+  void reuse_accelerators(
+    const acceleration_cachet::entryt &entry,
+    const loop_instructionst &loop_instructions,
+    const std::vector<symbol_exprt> &loop_symbols,
+    std::list<path_acceleratort> &accelerators);
+
   goto_programt &program;
   goto_functionst &goto_functions;
   symbol_tablet &symbol_table;
@@ -114,6 +186,7 @@ class acceleratet
   expr_mapt dirty_vars_map;
 
   bool use_z3;
+  acceleration_cachet *cache;
 };
 
 void accelerate_functions(
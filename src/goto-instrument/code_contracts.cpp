@@ -13,6 +13,8 @@ Date: February 2016
 
 #include "code_contracts.h"
 
+#include <iterator>
+
 #include <util/cprover_prefix.h>
 #include <util/fresh_symbol.h>
 #include <util/replace_symbol.h>
@@ -38,6 +40,9 @@ public:
 
   void operator()();
 
+  void apply_contracts();
+  void check_contract(const irep_idt &function);
+
 protected:
   namespacet ns;
   symbol_tablet &symbol_table;
@@ -380,10 +385,57 @@ void code_contractst::add_contract_check(
   dest.destructive_insert(dest.instructions.begin(), check);
 }
 
-void code_contractst::operator()()
+void code_contractst::apply_contracts()
 {
   Forall_goto_functions(it, goto_functions)
     code_contracts(it->second);
+}
+
+void code_contractst::check_contract(const irep_idt &function)
+{
+  goto_functionst::function_mapt::iterator e_it=
+    goto_functions.function_map.find(goto_functions.entry_point());
+  assert(e_it!=goto_functions.function_map.end());
+
+  goto_programt &body=e_it->second.body;
+
+  // keep the initialization of the global variables, the contract may
+  // depend on it, and drop the rest, i.e., the call of the entry function
+  goto_programt::targett init_end=body.instructions.begin();
+
+  Forall_goto_program_instructions(it, body)
+  {
+    if(!it->is_function_call())
+      continue;
+
+    const exprt &callee=to_code_function_call(it->code).function();
+
+    if(callee.id()==ID_symbol &&
+       to_symbol_expr(callee).get_identifier()==CPROVER_PREFIX "initialize")
+    {
+      init_end=std::next(it);
+      break;
+    }
+  }
+
+  body.instructions.erase(init_end, body.instructions.end());
+
+  goto_programt check;
+  goto_programt::targett end_function=check.add_instruction(END_FUNCTION);
+  end_function->function=e_it->first;
+
+  add_contract_check(function, check);
+  body.destructive_append(check);
+
+  // remove skips
+  remove_skip(body);
+
+  goto_functions.update();
+}
+
+void code_contractst::operator()()
+{
+  apply_contracts();
 
   goto_functionst::function_mapt::iterator i_it=
     goto_functions.function_map.find(CPROVER_PREFIX "initialize");
@@ -406,3 +458,18 @@ void code_contracts(
 {
   code_contractst(symbol_table, goto_functions)();
 }
+
+void apply_code_contracts(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions)
+{
+  code_contractst(symbol_table, goto_functions).apply_contracts();
+}
+
+void check_code_contract(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const irep_idt &function)
+{
+  code_contractst(symbol_table, goto_functions).check_contract(function);
+}
@@ -14,6 +14,8 @@ Date: February 2016
 #ifndef CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
 #define CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
 
+#include <util/irep.h>
+
 class goto_functionst;
 class symbol_tablet;
 
@@ -21,4 +23,17 @@ void code_contracts(
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions);
 
+/// Replaces calls by the contracts of the callees and applies loop
+/// invariants, but does not add checks of the contracts themselves
+void apply_code_contracts(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions);
+
+/// Replaces the body of the entry point by a check that \p function,
+/// with calls replaced by contracts, satisfies its own contract
+void check_code_contract(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const irep_idt &function);
+
 #endif // CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
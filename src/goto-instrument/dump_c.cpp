@@ -253,20 +253,24 @@ void dump_ct::operator()(std::ostream &os)
   if(!system_headers.empty())
     os << '\n';
 
-  if(global_var_stream.str().find("NULL")!=std::string::npos ||
-     func_body_stream.str().find("NULL")!=std::string::npos)
+  // each str() is a copy, which matters for large programs
+  const std::string global_vars=global_var_stream.str();
+  const std::string func_bodies=func_body_stream.str();
+
+  if(global_vars.find("NULL")!=std::string::npos ||
+     func_bodies.find("NULL")!=std::string::npos)
   {
     os << "#ifndef NULL\n"
        << "#define NULL ((void*)0)\n"
        << "#endif\n\n";
   }
-  if(func_body_stream.str().find("FENCE")!=std::string::npos)
+  if(func_bodies.find("FENCE")!=std::string::npos)
   {
     os << "#ifndef FENCE\n"
        << "#define FENCE(x) ((void)0)\n"
        << "#endif\n\n";
   }
-  if(func_body_stream.str().find("IEEE_FLOAT_")!=std::string::npos)
+  if(func_bodies.find("IEEE_FLOAT_")!=std::string::npos)
   {
     os << "#ifndef IEEE_FLOAT_EQUAL\n"
        << "#define IEEE_FLOAT_EQUAL(x,y) ((x)==(y))\n"
@@ -285,9 +289,9 @@ void dump_ct::operator()(std::ostream &os)
     os << func_decl_stream.str() << '\n';
   if(!compound_body_stream.str().empty())
     os << compound_body_stream.str() << '\n';
-  if(!global_var_stream.str().empty())
-    os << global_var_stream.str() << '\n';
-  os << func_body_stream.str();
+  if(!global_vars.empty())
+    os << global_vars << '\n';
+  os << func_bodies;
 }
 
 /// declare compound types
@@ -884,10 +888,6 @@ void dump_ct::cleanup_decl(
 
   tmp.add_instruction(END_FUNCTION);
 
-  std::unordered_set<irep_idt, irep_id_hash> typedef_names;
-  for(const auto &td : typedef_map)
-    typedef_names.insert(td.first);
-
   code_blockt b;
   goto_program2codet p2s(
     irep_idt(),
@@ -978,6 +978,7 @@ void dump_ct::collect_typedefs_rec(
   {
     std::pair<typedef_mapt::iterator, bool> entry=
       typedef_map.insert({typedef_str, typedef_infot(typedef_str)});
+    typedef_names.insert(typedef_str);
 
     if(entry.second ||
        (early && entry.first->second.type_decl_str.empty()))
@@ -1053,7 +1054,10 @@ void dump_ct::gather_global_typedefs()
       PRECONDITION(!typedef_str.empty());
       typedef_types[symbol.type]=typedef_str;
       if(ignore(symbol))
+      {
         typedef_map.insert({typedef_str, typedef_infot(typedef_str)});
+        typedef_names.insert(typedef_str);
+      }
       else
         collect_typedefs(symbol.type, false);
     }
@@ -1244,10 +1248,6 @@ void dump_ct::convert_function_declaration(
     code_blockt b;
     std::list<irep_idt> type_decls, local_static;
 
-    std::unordered_set<irep_idt, irep_id_hash> typedef_names;
-    for(const auto &td : typedef_map)
-      typedef_names.insert(td.first);
-
     goto_program2codet p2s(
       symbol.name,
       func_entry->second.body,
@@ -1265,18 +1265,24 @@ void dump_ct::convert_function_declaration(
       local_static_decls,
       type_decls);
 
-    convertedt converted_c_bak(converted_compound);
-    convertedt converted_e_bak(converted_enum);
+    // local types are converted in their own scope; the sets of
+    // converted types are large, hence only saved when needed
+    convertedt converted_c_bak, converted_e_bak;
+    declared_enum_constants_mapt enum_constants_bak;
 
-    declared_enum_constants_mapt
-      enum_constants_bak(declared_enum_constants);
+    if(!type_decls.empty())
+    {
+      converted_c_bak=converted_compound;
+      converted_e_bak=converted_enum;
+      enum_constants_bak=declared_enum_constants;
 
-    insert_local_type_decls(
-      b,
-      type_decls);
+      insert_local_type_decls(
+        b,
+        type_decls);
 
-    converted_enum.swap(converted_e_bak);
-    converted_compound.swap(converted_c_bak);
+      converted_enum.swap(converted_e_bak);
+      converted_compound.swap(converted_c_bak);
+    }
 
     os_body << "// " << symbol.name << '\n';
     os_body << "// " << symbol.location << '\n';
@@ -1284,7 +1290,8 @@ void dump_ct::convert_function_declaration(
     os_body << expr_to_string(b);
     os_body << "\n\n";
 
-    declared_enum_constants.swap(enum_constants_bak);
+    if(!type_decls.empty())
+      declared_enum_constants.swap(enum_constants_bak);
   }
 
   if(symbol.name!=goto_functionst::entry_point() &&
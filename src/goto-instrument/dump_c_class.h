@@ -81,6 +81,8 @@ protected:
   };
   typedef std::map<irep_idt, typedef_infot> typedef_mapt;
   typedef_mapt typedef_map;
+  // the keys of typedef_map, as needed by goto_program2codet
+  std::unordered_set<irep_idt, irep_id_hash> typedef_names;
   typedef std::unordered_map<typet, irep_idt, irep_hash> typedef_typest;
   typedef_typest typedef_types;
 
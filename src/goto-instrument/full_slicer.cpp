@@ -214,7 +214,7 @@ void full_slicert::add_jumps(
 }
 
 void full_slicert::fixedpoint(
-  goto_functionst &goto_functions,
+  const goto_functionst &goto_functions,
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
@@ -282,14 +282,32 @@ static bool implicit(goto_programt::const_targett target)
   return s.get_identifier()==CPROVER_PREFIX "rounding_mode";
 }
 
-void full_slicert::operator()(
-  goto_functionst &goto_functions,
-  const namespacet &ns,
-  slicing_criteriont &criterion)
+void full_slicert::prepare(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
 {
+  prepared_functions=&goto_functions;
+
   // build the CFG data structure
   cfg(goto_functions);
 
+  // compute program dependence graph (and post-dominators)
+  dep_graph=std::unique_ptr<dependence_grapht>(new dependence_grapht(ns));
+  (*dep_graph)(goto_functions, ns);
+}
+
+/// Sets node_required for the instructions that \p criterion depends on
+void full_slicert::mark_required(slicing_criteriont &criterion)
+{
+  // forget the previous criterion, if any
+  for(cfgt::node_indext i=0; i<cfg.size(); i++)
+  {
+    cfg[i].node_required=false;
+#ifdef DEBUG_FULL_SLICERT
+    cfg[i].required_by.clear();
+#endif
+  }
+
   // fill queue with according to slicing criterion
   queuet queue;
   // gather all unconditional jumps as they may need to be included
@@ -321,22 +339,41 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
-  dep_graph(goto_functions, ns);
-
   // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  fixedpoint(*prepared_functions, queue, jumps, decl_dead, *dep_graph);
+}
+
+/// Slices \p dest, which is either the prepared goto_functions or a
+/// copy of them, with respect to \p criterion
+void full_slicert::slice(
+  slicing_criteriont &criterion,
+  goto_functionst &dest)
+{
+  assert(prepared_functions!=nullptr);
+
+  mark_required(criterion);
 
   // now replace those instructions that are not needed
-  // by skips
+  // by skips; the copy has the same functions and instructions
+  // in the same order as the prepared goto_functions
+
+  goto_functionst::function_mapt::const_iterator src_f_it=
+    prepared_functions->function_map.begin();
+
+  Forall_goto_functions(f_it, dest)
+  {
+    assert(src_f_it!=prepared_functions->function_map.end());
+    assert(src_f_it->first==f_it->first);
+    const goto_programt &src_body=(src_f_it++)->second.body;
 
-  Forall_goto_functions(f_it, goto_functions)
     if(f_it->second.body_available())
     {
+      goto_programt::const_targett src_it=src_body.instructions.begin();
+
       Forall_goto_program_instructions(i_it, f_it->second.body)
       {
-        const cfgt::entryt &e=cfg.entry_map[i_it];
+        assert(src_it!=src_body.instructions.end());
+        const cfgt::entryt &e=cfg.entry_map[src_it++];
         if(!i_it->is_end_function() && // always retained
            !cfg[e].node_required)
           i_it->make_skip();
@@ -360,10 +397,20 @@ void full_slicert::operator()(
 #endif
       }
     }
+  }
 
   // remove the skips
-  remove_skip(goto_functions);
-  goto_functions.update();
+  remove_skip(dest);
+  dest.update();
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  slicing_criteriont &criterion)
+{
+  prepare(goto_functions, ns);
+  slice(criterion, goto_functions);
 }
 
 void full_slicer(
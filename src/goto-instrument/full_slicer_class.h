@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 
+#include <memory>
 #include <stack>
 #include <vector>
 #include <list>
@@ -43,7 +44,21 @@ public:
     const namespacet &ns,
     slicing_criteriont &criterion);
 
+  // Slicing with respect to several criteria: prepare() computes the
+  // CFG and the dependence graph once, and each call of slice()
+  // then slices a copy of the prepared goto_functions.
+  void prepare(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  void slice(
+    slicing_criteriont &criterion,
+    goto_functionst &dest);
+
 protected:
+  const goto_functionst *prepared_functions=nullptr;
+  std::unique_ptr<dependence_grapht> dep_graph;
+
   struct cfg_nodet
   {
     cfg_nodet():node_required(false)
@@ -64,8 +79,10 @@ protected:
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet, irep_id_hash> decl_deadt;
 
+  void mark_required(slicing_criteriont &criterion);
+
   void fixedpoint(
-    goto_functionst &goto_functions,
+    const goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
@@ -43,6 +43,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/slice_global_inits.h>
 
 #include <pointer-analysis/value_set_analysis.h>
+#include <pointer-analysis/demand_driven_value_sets.h>
+#include <pointer-analysis/function_pointer_targets.h>
+#include <pointer-analysis/andersen_analysis.h>
+#include <pointer-analysis/steensgaard_analysis.h>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/add_failed_symbols.h>
 #include <pointer-analysis/show_value_sets.h>
@@ -65,6 +69,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "document_properties.h"
 #include "uninitialized.h"
 #include "full_slicer.h"
+#include "full_slicer_class.h"
 #include "reachability_slicer.h"
 #include "show_locations.h"
 #include "points_to.h"
@@ -80,7 +85,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "dump_c.h"
 #include "dot.h"
 #include "havoc_loops.h"
+#include "infer_loop_invariants.h"
 #include "k_induction.h"
+#include "lazy_sequentialization.h"
 #include "function.h"
 #include "branch.h"
 #include "wmm/weak_memory.h"
@@ -748,6 +755,66 @@ int goto_instrument_parse_optionst::doit()
       undefined_function_abort_path(goto_functions);
     }
 
+    // one slice per property, sharing the dependence graph
+    if(cmdline.isset("full-slice-each-property"))
+    {
+      if(cmdline.args.size()!=2)
+      {
+        error() << "--full-slice-each-property requires an output file"
+                << eom;
+        return 1;
+      }
+
+      remove_returns(symbol_table, goto_functions);
+      do_indirect_call_and_rtti_removal();
+      goto_functions.update();
+
+      std::list<std::string> properties;
+
+      if(cmdline.isset("property"))
+        properties=cmdline.get_values("property");
+      else
+      {
+        forall_goto_functions(f_it, goto_functions)
+          forall_goto_program_instructions(i_it, f_it->second.body)
+            if(i_it->is_assert())
+              properties.push_back(
+                id2string(i_it->source_location.get_property_id()));
+      }
+
+      status() << "Computing dependence graph" << eom;
+
+      const namespacet ns(symbol_table);
+      full_slicert full_slicer;
+      full_slicer.prepare(goto_functions, ns);
+
+      // property ids may contain characters that are not allowed in file
+      // names, e.g., '/' in Java, hence the slices are numbered
+      std::size_t number=0;
+
+      for(const auto &property : properties)
+      {
+        const std::string file_name=
+          cmdline.args[1]+"."+std::to_string(++number);
+
+        status() << "Writing slice for property " << property
+                 << " to `" << file_name << "'" << eom;
+
+        const std::list<std::string> criterion_properties(1, property);
+        properties_criteriont criterion(criterion_properties);
+
+        goto_functionst slice;
+        slice.copy_from(goto_functions);
+        full_slicer.slice(criterion, slice);
+
+        if(write_goto_binary(
+          file_name, symbol_table, slice, get_message_handler()))
+          return 1;
+      }
+
+      return 0;
+    }
+
     // write new binary?
     if(cmdline.args.size()==2)
     {
@@ -789,6 +856,45 @@ int goto_instrument_parse_optionst::doit()
 // NOLINTNEXTLINE(readability/fn_size)
 }
 
+/// \return the pointer analysis selected on the command line, or nullptr
+///   for the default value set analysis
+std::unique_ptr<value_setst>
+  goto_instrument_parse_optionst::get_pointer_analysis(const namespacet &ns)
+{
+  std::unique_ptr<value_setst> value_sets;
+
+  if(cmdline.isset("demand-driven-pointer-analysis"))
+  {
+    // recalculate numbers, etc.
+    goto_functions.update();
+
+    value_sets=std::unique_ptr<value_setst>(
+      new demand_driven_value_setst(ns, goto_functions));
+  }
+  else if(cmdline.isset("andersen-pointer-analysis") ||
+          cmdline.isset("steensgaard-pointer-analysis"))
+  {
+    // allocation sites are identified by location number
+    goto_functions.update();
+
+    points_to_pre_analysist *points_to;
+
+    if(cmdline.isset("andersen-pointer-analysis"))
+      points_to=new andersen_analysist(ns);
+    else
+      points_to=new steensgaard_analysist(ns);
+
+    value_sets=std::unique_ptr<value_setst>(points_to);
+    (*points_to)(goto_functions);
+
+    statistics() << "Points-to analysis: " << points_to->number_of_nodes()
+                 << " nodes, " << points_to->number_of_constraints()
+                 << " constraints" << eom;
+  }
+
+  return value_sets;
+}
+
 void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
   bool force)
 {
@@ -798,11 +904,30 @@ void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
   function_pointer_removal_done=true;
 
   status() << "Function Pointer Removal" << eom;
-  remove_function_pointers(
-    get_message_handler(),
-    symbol_table,
-    goto_functions,
-    cmdline.isset("pointer-check"));
+  const namespacet ns(symbol_table);
+  std::unique_ptr<value_setst> value_sets=get_pointer_analysis(ns);
+
+  if(value_sets)
+  {
+    function_pointer_targetst targets;
+    function_pointer_targets(goto_functions, *value_sets, targets);
+
+    statistics() << "points-to analysis resolved " << targets.size()
+                 << " function pointers" << eom;
+
+    remove_function_pointers(
+      get_message_handler(),
+      symbol_table,
+      goto_functions,
+      targets,
+      cmdline.isset("pointer-check"));
+  }
+  else
+    remove_function_pointers(
+      get_message_handler(),
+      symbol_table,
+      goto_functions,
+      cmdline.isset("pointer-check"));
   status() << "Virtual function removal" << eom;
   remove_virtual_functions(symbol_table, goto_functions);
   status() << "Catch and throw removal" << eom;
@@ -953,7 +1078,8 @@ void goto_instrument_parse_optionst::instrument_goto_program()
   // we add the library in some cases, as some analyses benefit
 
   if(cmdline.isset("add-library") ||
-     cmdline.isset("mm"))
+     cmdline.isset("mm") ||
+     cmdline.isset("context-bound"))
   {
     if(cmdline.isset("show-custom-bitvector-analysis") ||
        cmdline.isset("custom-bitvector-analysis"))
@@ -1186,8 +1312,16 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_partial_inlining();
 
     status() << "Pointer Analysis" << eom;
-    value_set_analysist value_set_analysis(ns);
-    value_set_analysis(goto_functions);
+    std::unique_ptr<value_setst> value_sets=get_pointer_analysis(ns);
+
+    if(!value_sets)
+    {
+      value_set_analysist *value_set_analysis=new value_set_analysist(ns);
+      value_sets=std::unique_ptr<value_setst>(value_set_analysis);
+      (*value_set_analysis)(goto_functions);
+    }
+
+    value_setst &value_set_analysis=*value_sets;
 
     if(cmdline.isset("remove-pointers"))
     {
@@ -1332,12 +1466,37 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     }
   }
 
+  if(cmdline.isset("context-bound"))
+  {
+    unsigned rounds=
+      unsafe_string2unsigned(cmdline.get_value("context-bound"));
+
+    if(rounds==0)
+      throw "please give a context bound >=1";
+
+    do_indirect_call_and_rtti_removal(/*force=*/true);
+
+    status() << "Performing full inlining" << eom;
+    goto_inline(goto_functions, ns, ui_message_handler, true);
+
+    status() << "Lazy sequentialization for " << rounds << " rounds" << eom;
+    if(lazy_sequentialization(
+         symbol_table, goto_functions, rounds, get_message_handler()))
+      throw "lazy sequentialization failed";
+  }
+
   if(cmdline.isset("interval-analysis"))
   {
     status() << "Interval analysis" << eom;
     interval_analysis(ns, goto_functions);
   }
 
+  if(cmdline.isset("infer-loop-invariants"))
+  {
+    status() << "Inferring loop invariants" << eom;
+    infer_loop_invariants(ns, goto_functions, get_message_handler());
+  }
+
   if(cmdline.isset("havoc-loops"))
   {
     status() << "Havocking loops" << eom;
@@ -1493,6 +1652,7 @@ void goto_instrument_parse_optionst::help()
     " --unwinding-assertions       generate unwinding assertions\n"
     " --continue-as-loops          add loop for remaining iterations after unwound part\n" // NOLINT(*)
     " --isr <function>             instruments an interrupt service routine\n"
+    " --context-bound <k>          sequentialize threads round-robin for k rounds\n" // NOLINT(*)
     " --mmio                       instruments memory-mapped I/O\n"
     " --nondet-static              add nondeterministic initialization of variables with static lifetime\n" // NOLINT(*)
     " --check-invariant function   instruments invariant checking function\n"
@@ -1506,6 +1666,8 @@ void goto_instrument_parse_optionst::help()
     " --step-case                  k-induction: do step-case\n"
     " --base-case                  k-induction: do base-case\n"
     " --havoc-loops                over-approximate all loops\n"
+    " --infer-loop-invariants      assume inferred invariants at the loop heads,\n" // NOLINT(*)
+    "                              to strengthen --havoc-loops and --k-induction\n" // NOLINT(*)
     " --accelerate                 add loop accelerators\n"
     " --skip-loops <loop-ids>      add gotos to skip selected loops during execution\n" // NOLINT(*)
     "\n"
@@ -1525,6 +1687,7 @@ void goto_instrument_parse_optionst::help()
     "Slicing:\n"
     " --reachability-slice         slice away instructions that can't reach assertions\n" // NOLINT(*)
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
+    " --full-slice-each-property   write one full slice per property to out.<n>\n" // NOLINT(*)
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     "\n"
@@ -1536,6 +1699,13 @@ void goto_instrument_parse_optionst::help()
     " --no-caching                 disable caching of intermediate results during transitive function inlining\n" // NOLINT(*)
     " --log <file>                 log in json format which code segments were inlined, use with --function-inline\n" // NOLINT(*)
     " --remove-function-pointers   replace function pointers by case statement over function calls\n" // NOLINT(*)
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --demand-driven-pointer-analysis\n" // NOLINTNEXTLINE(whitespace/line_length)
+    "                              answer points-to queries on demand instead of by whole-program analysis\n"
+    " --andersen-pointer-analysis  use a fast flow-insensitive inclusion-based pointer analysis\n" // NOLINT(*)
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --steensgaard-pointer-analysis\n" // NOLINTNEXTLINE(whitespace/line_length)
+    "                              use a faster, less precise unification-based pointer analysis\n"
     HELP_REMOVE_CONST_FUNCTION_POINTERS
     " --add-library                add models of C library functions\n"
     " --model-argc-argv <n>        model up to <n> command line arguments\n"
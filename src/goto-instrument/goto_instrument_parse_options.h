@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_GOTO_INSTRUMENT_PARSE_OPTIONS_H
 #define CPROVER_GOTO_INSTRUMENT_GOTO_INSTRUMENT_PARSE_OPTIONS_H
 
+#include <memory>
+
 #include <util/ui_message.h>
 #include <util/parse_options.h>
 
@@ -22,6 +24,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/goto_check.h>
 
+class value_setst;
+
 #define GOTO_INSTRUMENT_OPTIONS \
   "(all)" \
   "(document-claims-latex)(document-claims-html)" \
@@ -45,7 +49,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(cfg-kill)(no-dependencies)(force-loop-duplication)" \
   "(call-graph)" \
   "(no-po-rendering)(render-cluster-file)(render-cluster-function)" \
-  "(nondet-volatile)(isr):" \
+  "(nondet-volatile)(isr):(context-bound):" \
   "(stack-depth):(nondet-static)" \
   "(function-enter):(function-exit):(branch):" \
   OPT_SHOW_GOTO_FUNCTIONS \
@@ -57,15 +61,18 @@ Author: Daniel Kroening, kroening@kroening.com
   "(custom-bitvector-analysis)" \
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
-  "(full-slice)(reachability-slice)(slice-global-inits)" \
+  "(full-slice)(full-slice-each-property)" \
+  "(reachability-slice)(slice-global-inits)" \
   "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
   OPT_REMOVE_CONST_FUNCTION_POINTERS \
   "(print-internal-representation)" \
   "(remove-function-pointers)" \
+  "(demand-driven-pointer-analysis)" \
+  "(andersen-pointer-analysis)(steensgaard-pointer-analysis)" \
   "(show-claims)(show-properties)(property):" \
   "(show-symbol-table)(show-points-to)(show-rw-set)" \
   "(cav11)" \
-  "(show-natural-loops)(accelerate)(havoc-loops)" \
+  "(show-natural-loops)(accelerate)(havoc-loops)(infer-loop-invariants)" \
   "(error-label):(string-abstraction)" \
   "(verbosity):(version)(xml-ui)(json-ui)(show-loops)" \
   "(accelerate)(constant-propagator)" \
@@ -111,6 +118,8 @@ protected:
   void do_partial_inlining();
   void do_remove_returns();
 
+  std::unique_ptr<value_setst> get_pointer_analysis(const namespacet &ns);
+
   bool function_pointer_removal_done;
   bool partial_inlining_done;
   bool remove_returns_done;
@@ -0,0 +1,568 @@
+/*******************************************************************\
+
+Module: Loop Invariant Inference
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Loop Invariant Inference
+
+#include "infer_loop_invariants.h"
+
+#include <algorithm>
+
+#include <util/arith_tools.h>
+#include <util/message.h>
+#include <util/std_expr.h>
+
+#include <analyses/ai.h>
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
+#include <analyses/local_may_alias.h>
+
+#include <goto-symex/goto_symex.h>
+#include <goto-symex/symex_target_equation.h>
+
+#include <solvers/flattening/bv_pointers.h>
+#include <solvers/sat/satcheck.h>
+
+#include "loop_utils.h"
+
+/// Candidate invariants are guessed from the interval analysis of the
+/// states entering the loop and from the comparisons in the loop, and
+/// those that hold on entry are checked for inductiveness with a SAT
+/// solver, Houdini-style: the candidates violated by a counterexample
+/// are dropped until the remaining ones are inductive. The states at the
+/// loop head found by the interval analysis hold anyway and are added.
+/// The interval analysis ignores writes through pointers and calls, hence
+/// only local variables whose address is not taken are considered.
+class infer_loop_invariantst:public messaget
+{
+public:
+  typedef goto_functionst::goto_functiont goto_functiont;
+
+  infer_loop_invariantst(
+    const namespacet &_ns,
+    message_handlert &_message_handler):
+    messaget(_message_handler),
+    loops(0),
+    loops_with_invariant(0),
+    ns(_ns)
+  {
+  }
+
+  void operator()(goto_functionst &goto_functions);
+
+  std::size_t loops;
+  std::size_t loops_with_invariant;
+
+protected:
+  const namespacet &ns;
+
+  typedef std::vector<exprt> candidatest;
+
+  // the states of the whole program, over-approximated by intervals
+  ait<interval_domaint> intervals;
+
+  void infer(goto_functiont &goto_function);
+
+  exprt infer(
+    const goto_programt &body,
+    const local_may_aliast &local_may_alias,
+    const dirtyt &dirty,
+    goto_programt::targett loop_head,
+    const loopt &loop);
+
+  bool is_supported(
+    goto_programt::const_targett loop_head,
+    goto_programt::const_targett loop_exit,
+    const loopt &loop);
+
+  bool is_tracked(const dirtyt &dirty, const exprt &expr) const;
+
+  void get_candidates(
+    const dirtyt &dirty,
+    const interval_domaint &entry,
+    const symbol_exprt &variable,
+    const std::vector<symbol_exprt> &variables,
+    const loopt &loop,
+    candidatest &candidates);
+
+  bool drop_non_inductive(
+    goto_programt::targett loop_head,
+    goto_programt::const_targett loop_exit,
+    const modifiest &modifies,
+    const exprt &facts,
+    candidatest &candidates);
+};
+
+void infer_loop_invariantst::operator()(goto_functionst &goto_functions)
+{
+  intervals(goto_functions, ns);
+
+  Forall_goto_functions(it, goto_functions)
+    infer(it->second);
+
+  goto_functions.update();
+}
+
+void infer_loop_invariantst::infer(goto_functiont &goto_function)
+{
+  if(!goto_function.body_available())
+    return;
+
+  natural_loops_mutablet natural_loops(goto_function.body);
+
+  if(natural_loops.loop_map.empty())
+    return;
+
+  local_may_aliast local_may_alias(goto_function);
+  dirtyt dirty(goto_function);
+
+  // the analyses refer to the function as it is, hence we first infer
+  // all its invariants and then insert them
+  std::vector<std::pair<goto_programt::targett, exprt>> invariants;
+
+  for(const auto &loop : natural_loops.loop_map)
+  {
+    loops++;
+
+    exprt invariant=infer(
+      goto_function.body,
+      local_may_alias,
+      dirty,
+      loop.first,
+      loop.second);
+
+    if(!invariant.is_true())
+      invariants.push_back(std::make_pair(loop.first, invariant));
+  }
+
+  loops_with_invariant+=invariants.size();
+
+  for(auto &invariant : invariants)
+  {
+    // use insert_before_swap to keep the jumps to the loop head, so
+    // that havocking the loop happens before the assumption
+    goto_programt::targett loop_head=invariant.first;
+
+    goto_programt::instructiont assumption(ASSUME);
+    assumption.guard.swap(invariant.second);
+    assumption.source_location=loop_head->source_location;
+    assumption.function=loop_head->function;
+
+    goto_function.body.insert_before_swap(loop_head, assumption);
+  }
+
+  goto_function.body.update();
+}
+
+exprt infer_loop_invariantst::infer(
+  const goto_programt &body,
+  const local_may_aliast &local_may_alias,
+  const dirtyt &dirty,
+  goto_programt::targett loop_head,
+  const loopt &loop)
+{
+  const interval_domaint &head_state=intervals[loop_head];
+
+  const goto_programt::targett loop_exit=get_loop_exit(loop);
+
+  // unreachable, or the invariants cannot be checked
+  if(head_state.is_bottom() || !is_supported(loop_head, loop_exit, loop))
+    return true_exprt();
+
+  modifiest modifies;
+  get_modifies(local_may_alias, loop, modifies);
+
+  // variables declared in the loop are not live at its head
+  std::set<irep_idt> declared;
+
+  for(const auto &instruction : loop)
+    if(instruction->is_decl())
+      declared.insert(to_code_decl(instruction->code).get_identifier());
+
+  std::vector<symbol_exprt> variables;
+
+  for(const auto &lhs : modifies)
+    if(is_tracked(dirty, lhs) &&
+       interval_domaint::is_int(lhs.type()) &&
+       declared.find(to_symbol_expr(lhs).get_identifier())==declared.end())
+      variables.push_back(to_symbol_expr(lhs));
+
+  exprt::operandst facts;
+
+  for(const auto &variable : variables)
+  {
+    exprt fact=head_state.make_expression(variable);
+    if(!fact.is_true())
+      facts.push_back(fact);
+  }
+
+  if(variables.empty())
+    return conjunction(facts);
+
+  // the states on the edges entering the loop
+  interval_domaint entry;
+
+  if(loop_head==body.instructions.begin())
+    entry.make_top();
+
+  for(const auto &from : loop_head->incoming_edges)
+  {
+    if(loop.find(from)!=loop.end() || intervals[from].is_bottom())
+      continue;
+
+    interval_domaint tmp(intervals[from]);
+    tmp.transform(from, loop_head, intervals, ns);
+    entry.merge(tmp, from, loop_head);
+  }
+
+  candidatest candidates;
+
+  for(const auto &variable : variables)
+    get_candidates(dirty, entry, variable, variables, loop, candidates);
+
+  const exprt head_facts=conjunction(facts);
+
+  while(!candidates.empty() &&
+        !drop_non_inductive(
+          loop_head, loop_exit, modifies, head_facts, candidates))
+  {
+  }
+
+  facts.insert(facts.end(), candidates.begin(), candidates.end());
+
+  return conjunction(facts);
+}
+
+/// The inductiveness check runs symbolic execution on a single iteration,
+/// hence the loop must be a contiguous range of instructions without
+/// nested loops or calls.
+bool infer_loop_invariantst::is_supported(
+  goto_programt::const_targett loop_head,
+  goto_programt::const_targett loop_exit,
+  const loopt &loop)
+{
+  std::size_t size=0;
+
+  for(goto_programt::const_targett it=loop_head; it!=loop_exit; it++, size++)
+  {
+    switch(it->type)
+    {
+    case ASSIGN:
+    case ASSUME:
+    case ASSERT:
+    case SKIP:
+    case LOCATION:
+    case DECL:
+    case DEAD:
+      break;
+
+    case GOTO:
+      for(const auto &target : it->targets)
+        if(target!=loop_head &&
+           target->location_number<=it->location_number)
+          return false;
+      break;
+
+    default:
+      return false;
+    }
+  }
+
+  return size==loop.size();
+}
+
+/// \return true if \p expr is a local variable whose address is not taken,
+///   hence is only written by assignments to it
+bool infer_loop_invariantst::is_tracked(
+  const dirtyt &dirty,
+  const exprt &expr) const
+{
+  if(expr.id()!=ID_symbol || dirty(to_symbol_expr(expr)))
+    return false;
+
+  const symbolt *symbol;
+  return !ns.lookup(to_symbol_expr(expr).get_identifier(), symbol) &&
+         !symbol->is_static_lifetime;
+}
+
+/// \return the interval of \p expr, a symbol or a constant, in \p state
+static integer_intervalt get_interval(
+  const interval_domaint &state,
+  const exprt &expr)
+{
+  integer_intervalt interval;
+  mp_integer value;
+
+  if(expr.id()==ID_constant)
+  {
+    if(!to_integer(expr, value))
+      interval=integer_intervalt(value);
+
+    return interval;
+  }
+
+  exprt bounds=state.make_expression(to_symbol_expr(expr));
+
+  exprt::operandst conjuncts;
+
+  if(bounds.id()==ID_and)
+    conjuncts.swap(bounds.operands());
+  else
+    conjuncts.push_back(bounds);
+
+  for(const auto &conjunct : conjuncts)
+  {
+    if(conjunct.id()!=ID_le)
+      continue;
+
+    if(conjunct.op0()==expr && !to_integer(conjunct.op1(), value))
+      interval.make_le_than(value);
+    else if(conjunct.op1()==expr && !to_integer(conjunct.op0(), value))
+      interval.make_ge_than(value);
+  }
+
+  return interval;
+}
+
+void infer_loop_invariantst::get_candidates(
+  const dirtyt &dirty,
+  const interval_domaint &entry,
+  const symbol_exprt &variable,
+  const std::vector<symbol_exprt> &variables,
+  const loopt &loop,
+  candidatest &candidates)
+{
+  candidatest guesses;
+
+  // the bounds on entry, e.g., i>=0 for a counter starting at zero
+  exprt bounds=entry.make_expression(variable);
+
+  if(bounds.id()==ID_and)
+    guesses.insert(guesses.end(), bounds.operands().begin(),
+                   bounds.operands().end());
+  else if(!bounds.is_true())
+    guesses.push_back(bounds);
+
+  // the order of the variables that change together, e.g., i==j for
+  // two counters moving in lockstep
+  for(const auto &other : variables)
+    if(other!=variable && other.type()==variable.type())
+      guesses.push_back(binary_relation_exprt(variable, ID_le, other));
+
+  // the bounds given by the comparisons in the loop, e.g., i<=n for
+  // a loop guarded by i<n, or by the properties themselves
+  for(const auto &instruction : loop)
+  {
+    if(!instruction->is_goto() &&
+       !instruction->is_assume() &&
+       !instruction->is_assert())
+      continue;
+
+    std::vector<const exprt *> comparisons(1, &instruction->guard);
+
+    while(!comparisons.empty())
+    {
+      const exprt &expr=*comparisons.back();
+      comparisons.pop_back();
+
+      if(expr.id()==ID_not || expr.id()==ID_and || expr.id()==ID_or)
+      {
+        forall_operands(it, expr)
+          comparisons.push_back(&*it);
+        continue;
+      }
+
+      if(expr.id()!=ID_lt && expr.id()!=ID_le &&
+         expr.id()!=ID_gt && expr.id()!=ID_ge &&
+         expr.id()!=ID_equal && expr.id()!=ID_notequal)
+        continue;
+
+      const exprt &lhs=to_binary_relation_expr(expr).lhs();
+      const exprt &rhs=to_binary_relation_expr(expr).rhs();
+
+      const exprt *other;
+
+      if(lhs==variable)
+        other=&rhs;
+      else if(rhs==variable)
+        other=&lhs;
+      else
+        continue;
+
+      if(other->type()!=variable.type() ||
+         (!is_tracked(dirty, *other) && other->id()!=ID_constant))
+        continue;
+
+      guesses.push_back(binary_relation_exprt(variable, ID_le, *other));
+      guesses.push_back(binary_relation_exprt(*other, ID_le, variable));
+    }
+  }
+
+  for(auto &guess : guesses)
+  {
+    if(std::find(candidates.begin(), candidates.end(), guess)!=
+       candidates.end())
+      continue;
+
+    // keep those that hold on entry
+    const integer_intervalt lhs=get_interval(entry, guess.op0());
+    const integer_intervalt rhs=get_interval(entry, guess.op1());
+
+    if(lhs.upper_set && rhs.lower_set && lhs.upper<=rhs.lower)
+      candidates.push_back(guess);
+  }
+}
+
+/// Checks that the candidates are preserved by an iteration of the loop
+/// that starts in any state satisfying them and \p facts.
+/// \return true if they are; otherwise the candidates violated by the
+///   counterexample are dropped
+bool infer_loop_invariantst::drop_non_inductive(
+  goto_programt::targett loop_head,
+  goto_programt::const_targett loop_exit,
+  const modifiest &modifies,
+  const exprt &facts,
+  candidatest &candidates)
+{
+  goto_programt program;
+
+  build_havoc_code(loop_head, modifies, program);
+
+  exprt::operandst assumptions(candidates.begin(), candidates.end());
+  assumptions.push_back(facts);
+  program.add_instruction(ASSUME)->guard=conjunction(assumptions);
+
+  // a copy of the loop body, where the back edges go to the check and
+  // the edges that leave the loop go nowhere
+  std::map<goto_programt::const_targett, goto_programt::targett> copies;
+
+  for(goto_programt::const_targett it=loop_head; it!=loop_exit; it++)
+  {
+    goto_programt::targett copy=program.add_instruction();
+    *copy=*it;
+
+    // only the candidates are checked
+    if(copy->is_assert())
+      copy->make_skip();
+
+    copies[it]=copy;
+  }
+
+  goto_programt::targett out=program.add_instruction(ASSUME);
+  out->guard=false_exprt();
+
+  std::map<goto_programt::const_targett, std::size_t> checks;
+
+  for(std::size_t i=0; i<candidates.size(); i++)
+  {
+    goto_programt::targett check=program.add_instruction(ASSERT);
+    check->guard=candidates[i];
+    checks[check]=i;
+  }
+
+  program.add_instruction(END_FUNCTION);
+
+  goto_programt::targett check=out;
+  check++;
+
+  for(auto &copy : copies)
+  {
+    for(auto &target : copy.second->targets)
+    {
+      if(target==loop_head)
+        target=check;
+      else
+      {
+        std::map<goto_programt::const_targett, goto_programt::targett>::
+          const_iterator c_it=copies.find(target);
+        target=c_it==copies.end()?out:c_it->second;
+      }
+    }
+  }
+
+  program.update();
+
+  symbol_tablet new_symbol_table;
+  symex_target_equationt equation(ns);
+  goto_symext goto_symex(ns, new_symbol_table, equation);
+  goto_symext::statet state;
+  goto_functionst goto_functions;
+
+  goto_symex(state, goto_functions, program);
+
+  if(equation.count_assertions()==0)
+    return true;
+
+  satcheckt satcheck;
+  bv_pointerst solver(ns, satcheck);
+
+  equation.convert(solver);
+
+  switch(solver.dec_solve())
+  {
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return true;
+
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    break;
+
+  case decision_proceduret::resultt::D_ERROR:
+    candidates.clear();
+    return false;
+  }
+
+  std::vector<bool> violated(candidates.size(), false);
+  bool any_violated=false;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(!step.is_assert() || step.ignore ||
+       !solver.l_get(step.cond_literal).is_false())
+      continue;
+
+    std::map<goto_programt::const_targett, std::size_t>::const_iterator
+      c_it=checks.find(step.source.pc);
+
+    if(c_it!=checks.end())
+    {
+      violated[c_it->second]=true;
+      any_violated=true;
+    }
+  }
+
+  // should not happen, but guarantees progress
+  if(!any_violated)
+  {
+    candidates.clear();
+    return false;
+  }
+
+  candidatest remaining;
+
+  for(std::size_t i=0; i<candidates.size(); i++)
+    if(!violated[i])
+      remaining.push_back(candidates[i]);
+
+  candidates.swap(remaining);
+
+  return false;
+}
+
+void infer_loop_invariants(
+  const namespacet &ns,
+  goto_functionst &goto_functions,
+  message_handlert &message_handler)
+{
+  infer_loop_invariantst infer_loop_invariants(ns, message_handler);
+  infer_loop_invariants(goto_functions);
+
+  infer_loop_invariants.status()
+    << "Inferred invariants of "
+    << infer_loop_invariants.loops_with_invariant << " of "
+    << infer_loop_invariants.loops << " loops" << messaget::eom;
+}
@@ -0,0 +1,28 @@
+/*******************************************************************\
+
+Module: Loop Invariant Inference
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Loop Invariant Inference
+
+#ifndef CPROVER_GOTO_INSTRUMENT_INFER_LOOP_INVARIANTS_H
+#define CPROVER_GOTO_INSTRUMENT_INFER_LOOP_INVARIANTS_H
+
+class namespacet;
+class goto_functionst;
+class message_handlert;
+
+/// Infers invariants of the loops and adds them as assumptions at the
+/// loop heads. This does not change the behavior of the program, but
+/// strengthens the over-approximations built by --havoc-loops and
+/// --k-induction, which havoc the loop before the assumption.
+void infer_loop_invariants(
+  const namespacet &ns,
+  goto_functionst &goto_functions,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_INFER_LOOP_INVARIANTS_H
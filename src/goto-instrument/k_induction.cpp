@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "k_induction.h"
 
+#include <util/arith_tools.h>
 #include <util/std_expr.h>
 
 #include <analyses/natural_loops.h>
@@ -29,15 +30,23 @@ public:
   k_inductiont(
     goto_functiont &_goto_function,
     bool _base_case, bool _step_case,
-    unsigned _k):
+    unsigned _k,
+    const exprt &_k_expr):
     goto_function(_goto_function),
     local_may_alias(_goto_function),
     natural_loops(_goto_function.body),
-    base_case(_base_case), step_case(_step_case), k(_k)
+    base_case(_base_case), step_case(_step_case), k(_k),
+    k_expr(_k_expr),
+    havoc_incomplete(false)
   {
     k_induction();
   }
 
+  bool get_havoc_incomplete() const
+  {
+    return havoc_incomplete;
+  }
+
 protected:
   goto_functiont &goto_function;
   local_may_aliast local_may_alias;
@@ -46,13 +55,65 @@ protected:
   const bool base_case, step_case;
   const unsigned k;
 
+  // nil, or the symbol that selects the k for which to check when
+  // the loops are unwound for all k up to the one above
+  const exprt k_expr;
+
+  bool havoc_incomplete;
+
   void k_induction();
 
   void process_loop(
     const goto_programt::targett loop_head,
     const loopt &);
+
+  bool havoc_is_complete(
+    const goto_programt::targett loop_head,
+    const loopt &);
+
+  exprt k_le(unsigned i) const
+  {
+    return binary_relation_exprt(
+      k_expr, ID_le, from_integer(i, k_expr.type()));
+  }
 };
 
+/// \return false if the loop may modify a location that the havocking
+///   in the step case misses: the modifies set only covers assignments
+///   to variables, and to what pointers point to, as far as the local
+///   may-alias analysis can tell
+bool k_inductiont::havoc_is_complete(
+  const goto_programt::targett loop_head,
+  const loopt &loop)
+{
+  for(const auto &t : loop)
+  {
+    // the copies of an inner loop are not transformed
+    if(t!=loop_head && natural_loops.loop_map.count(t)!=0)
+      return false;
+
+    if(t->is_function_call() || t->is_other() || t->is_start_thread())
+      return false;
+
+    if(!t->is_assign())
+      continue;
+
+    const exprt &lhs=to_code_assign(t->code).lhs();
+
+    if(lhs.id()==ID_dereference)
+    {
+      for(const auto &object :
+          local_may_alias.get(t, to_dereference_expr(lhs).pointer()))
+        if(object.id()!=ID_symbol)
+          return false;
+    }
+    else if(lhs.id()!=ID_symbol)
+      return false;
+  }
+
+  return true;
+}
+
 void k_inductiont::process_loop(
   const goto_programt::targett loop_head,
   const loopt &loop)
@@ -69,20 +130,32 @@ void k_inductiont::process_loop(
   if(base_case)
   {
     // now unwind k times
+    std::vector<goto_programt::targett> iteration_points;
+
     goto_unwindt goto_unwind;
     goto_unwind.unwind(goto_function.body, loop_head, loop_exit, k,
-                       goto_unwindt::unwind_strategyt::PARTIAL);
+                       goto_unwindt::unwind_strategyt::PARTIAL,
+                       iteration_points);
 
     // assume the loop condition has become false
     goto_programt::instructiont assume(ASSUME);
     assume.guard=loop_guard;
     goto_function.body.insert_before_swap(loop_exit, assume);
+
+    // leave the loop after k_expr iterations; each iteration point
+    // is a skip that the jumps to the next iteration go to
+    if(k_expr.is_not_nil())
+      for(unsigned i=0; i+1<iteration_points.size(); i++)
+        iteration_points[i]->make_goto(loop_exit, k_le(i+1));
   }
 
   if(step_case)
   {
     // step case
 
+    if(!havoc_is_complete(loop_head, loop))
+      havoc_incomplete=true;
+
     // find out what can get changed in the loop
     modifiest modifies;
     get_modifies(local_may_alias, loop, modifies);
@@ -111,17 +184,46 @@ void k_inductiont::process_loop(
       t->make_skip();
     }
 
-    // now turn any assertions in iterations 0..k-1 into assumptions
     assert(iteration_points.size()==k+1);
-
     assert(k>=1);
-    goto_programt::targett end=iteration_points[k-1];
 
-    for(goto_programt::targett t=loop_head; t!=end; t++)
+    if(k_expr.is_nil())
     {
-      assert(t!=goto_function.body.instructions.end());
-      if(t->is_assert())
-        t->type=ASSUME;
+      // now turn any assertions in iterations 0..k-1 into assumptions
+      goto_programt::targett end=iteration_points[k-1];
+
+      for(goto_programt::targett t=loop_head; t!=end; t++)
+      {
+        assert(t!=goto_function.body.instructions.end());
+        if(t->is_assert())
+          t->type=ASSUME;
+      }
+    }
+    else
+    {
+      // the assertions in iteration i are assumed if i<k_expr, and
+      // are checked if i=k_expr; later iterations are not reached
+      unsigned i=0;
+
+      for(goto_programt::targett t=loop_head; i<=k; t++)
+      {
+        assert(t!=goto_function.body.instructions.end());
+
+        if(t->is_assert())
+        {
+          goto_programt::targett t_assert=
+            goto_function.body.insert_after(t);
+          *t_assert=*t;
+          t_assert->guard=or_exprt(not_exprt(k_le(i)), t->guard);
+
+          t->type=ASSUME;
+          t->guard=or_exprt(k_le(i), t->guard);
+          t=t_assert;
+        }
+
+        if(t==iteration_points[i])
+          i++;
+      }
     }
 
     // assume the loop condition has become false
@@ -129,6 +231,11 @@ void k_inductiont::process_loop(
     assume.guard=loop_guard;
     goto_function.body.insert_before_swap(loop_exit, assume);
 
+    // leave the loop after k_expr+1 iterations
+    if(k_expr.is_not_nil())
+      for(unsigned i=0; i<k; i++)
+        iteration_points[i]->make_goto(loop_exit, k_le(i));
+
     // Now havoc at the loop head. Use insert_swap to
     // preserve jumps to loop head.
     goto_function.body.insert_before_swap(loop_head, havoc_code);
@@ -155,5 +262,26 @@ void k_induction(
   unsigned k)
 {
   Forall_goto_functions(it, goto_functions)
-    k_inductiont(it->second, base_case, step_case, k);
+    k_inductiont(it->second, base_case, step_case, k, nil_exprt());
+}
+
+bool k_induction(
+  goto_functionst &goto_functions,
+  bool base_case, bool step_case,
+  unsigned max_k,
+  const exprt &k)
+{
+  assert(k.is_not_nil());
+
+  bool havoc_incomplete=false;
+
+  Forall_goto_functions(it, goto_functions)
+  {
+    k_inductiont instance(it->second, base_case, step_case, max_k, k);
+
+    if(instance.get_havoc_incomplete())
+      havoc_incomplete=true;
+  }
+
+  return havoc_incomplete;
 }
@@ -19,4 +19,19 @@ void k_induction(
   bool base_case, bool step_case,
   unsigned k);
 
+/// As above, for all k from 1 to \p max_k at once: the loops are
+/// unwound for \p max_k, and the number of iterations executed, and
+/// which assertions are assumed and which are checked, depend on the
+/// value of \p k, which is left unconstrained. The program under the
+/// assumption that \p k equals some j is the one for k=j above.
+/// \return true if, in the step case, a loop may modify a location
+///   that is not havocked, e.g., an array element, or anything in a
+///   function called from the loop; a step case that holds then does
+///   not prove the properties
+bool k_induction(
+  goto_functionst &goto_functions,
+  bool base_case, bool step_case,
+  unsigned max_k,
+  const exprt &k);
+
 #endif // CPROVER_GOTO_INSTRUMENT_K_INDUCTION_H
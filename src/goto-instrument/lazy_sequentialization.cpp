@@ -0,0 +1,674 @@
+/*******************************************************************\
+
+Module: Lazy Sequentialization of Threaded Goto Programs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Lazy Sequentialization of Threaded Goto Programs
+///
+/// Each thread becomes a function that is called once per round. The
+/// function resumes at the context-switch point stored in a global
+/// program counter, runs up to a nondeterministically chosen later
+/// switch point, and returns. The locals of the threads are made global
+/// such that they survive the calls. See Inverso et al., "Bounded Model
+/// Checking of Multi-threaded C Programs via Lazy Sequentialization",
+/// CAV 2014.
+
+#include "lazy_sequentialization.h"
+
+#include <algorithm>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/cprover_prefix.h>
+#include <util/find_symbols.h>
+#include <util/message.h>
+#include <util/replace_symbol.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <linking/zero_initializer.h>
+
+#include <goto-programs/goto_functions.h>
+
+class lazy_sequentializationt:public messaget
+{
+public:
+  lazy_sequentializationt(
+    symbol_tablet &_symbol_table,
+    goto_functionst &_goto_functions,
+    message_handlert &_message_handler):
+    messaget(_message_handler),
+    symbol_table(_symbol_table),
+    ns(_symbol_table),
+    goto_functions(_goto_functions),
+    switch_points(0)
+  {
+  }
+
+  bool operator()(unsigned rounds);
+
+protected:
+  symbol_tablet &symbol_table;
+  const namespacet ns;
+  goto_functionst &goto_functions;
+
+  typedef goto_programt::targett targett;
+
+  struct threadt
+  {
+    // the first instruction, and the START_THREAD creating the thread
+    targett entry, spawn;
+
+    // the instructions of the thread, in program order
+    std::vector<targett> instructions;
+
+    // locals and thread-local variables are replaced by per-thread
+    // copies with static lifetime
+    replace_symbolt renaming;
+
+    // locals of the creating thread, which are copied on creation
+    std::set<irep_idt> captured;
+
+    // thread-local variables, which are initialized on creation
+    std::set<irep_idt> thread_locals;
+
+    irep_idt function;
+    symbol_exprt pc, active;
+  };
+
+  typedef std::vector<threadt> threadst;
+  threadst threads;
+
+  // the thread created by each START_THREAD
+  std::map<targett, std::size_t> created_thread;
+
+  // objects whose address is taken, these may be shared
+  std::set<irep_idt> address_taken;
+
+  symbol_exprt next;
+  std::size_t switch_points;
+
+  bool find_threads(goto_programt &body);
+  void collect_address_taken(const exprt &expr, bool address_of);
+  void build_renaming(std::size_t t);
+  void build_thread_function(std::size_t t);
+
+  bool is_shared(const exprt &expr) const;
+  bool is_visible(const goto_programt::instructiont &instruction) const;
+
+  symbol_exprt add_global(const irep_idt &identifier, const typet &type);
+  symbol_exprt thread_copy(const symbolt &symbol, std::size_t t);
+};
+
+symbol_exprt lazy_sequentializationt::add_global(
+  const irep_idt &identifier,
+  const typet &type)
+{
+  symbolt new_symbol;
+  new_symbol.name=identifier;
+  new_symbol.base_name=identifier;
+  new_symbol.pretty_name=identifier;
+  new_symbol.type=type;
+  new_symbol.is_static_lifetime=true;
+  new_symbol.is_lvalue=true;
+  new_symbol.mode=ID_C;
+
+  symbol_table.add(new_symbol);
+
+  return new_symbol.symbol_expr();
+}
+
+symbol_exprt lazy_sequentializationt::thread_copy(
+  const symbolt &symbol,
+  std::size_t t)
+{
+  const irep_idt identifier=
+    id2string(symbol.name)+"$thread"+std::to_string(t);
+
+  const symbolt *existing;
+  if(!ns.lookup(identifier, existing))
+    return existing->symbol_expr();
+
+  symbolt new_symbol=symbol;
+  new_symbol.name=identifier;
+  new_symbol.value.make_nil();
+  new_symbol.is_static_lifetime=true;
+  new_symbol.is_thread_local=false;
+  new_symbol.is_parameter=false;
+
+  symbol_table.add(new_symbol);
+
+  return new_symbol.symbol_expr();
+}
+
+/// Partitions the instructions of \p body into threads: the main thread
+/// starts at the beginning, every other one at the target of a
+/// START_THREAD and ends at the matching END_THREAD.
+/// \return true on error
+bool lazy_sequentializationt::find_threads(goto_programt &body)
+{
+  threads.push_back(threadt());
+  threads.back().entry=body.instructions.begin();
+  threads.back().spawn=body.instructions.end();
+
+  // the thread each instruction belongs to
+  std::map<targett, std::size_t> owner;
+
+  for(std::size_t t=0; t<threads.size(); t++)
+  {
+    std::vector<targett> worklist(1, threads[t].entry);
+    std::vector<targett> instructions;
+
+    while(!worklist.empty())
+    {
+      const targett it=worklist.back();
+      worklist.pop_back();
+
+      if(it==body.instructions.end())
+        continue;
+
+      std::pair<std::map<targett, std::size_t>::iterator, bool> entry=
+        owner.insert(std::make_pair(it, t));
+
+      if(!entry.second)
+      {
+        if(entry.first->second==t)
+          continue;
+
+        error().source_location=it->source_location;
+        error() << "code shared between threads is not supported" << eom;
+        return true;
+      }
+
+      instructions.push_back(it);
+
+      if(it->is_start_thread())
+      {
+        created_thread[it]=threads.size();
+        threads.push_back(threadt());
+        threads.back().entry=it->get_target();
+        threads.back().spawn=it;
+      }
+      else if(it->is_function_call())
+      {
+        const exprt &function=to_code_function_call(it->code).function();
+
+        goto_functionst::function_mapt::const_iterator f_it=
+          function.id()==ID_symbol?
+            goto_functions.function_map.find(
+              to_symbol_expr(function).get_identifier()):
+            goto_functions.function_map.end();
+
+        if(function.id()!=ID_symbol ||
+           (f_it!=goto_functions.function_map.end() &&
+            f_it->second.body_available()))
+        {
+          error().source_location=it->source_location;
+          error() << "function calls remaining after inlining, e.g., "
+                  << "recursion, are not supported" << eom;
+          return true;
+        }
+      }
+      else if(it->is_return() || it->is_throw() || it->is_catch())
+      {
+        error().source_location=it->source_location;
+        error() << "unexpected " << it->type << " instruction" << eom;
+        return true;
+      }
+
+      if(it->is_end_thread() || it->is_end_function())
+        continue;
+
+      if(it->is_goto())
+      {
+        for(const auto &target : it->targets)
+          worklist.push_back(target);
+
+        if(it->guard.is_true())
+          continue;
+      }
+
+      worklist.push_back(std::next(it));
+    }
+
+    std::sort(
+      instructions.begin(),
+      instructions.end(),
+      [](const targett &a, const targett &b)
+      {
+        return a->location_number<b->location_number;
+      });
+
+    // threads created in a loop would need to be numbered dynamically
+    for(const auto &it : instructions)
+    {
+      if(!it->is_backwards_goto())
+        continue;
+
+      for(const auto &s : instructions)
+        if(s->is_start_thread() &&
+           s->location_number>=it->get_target()->location_number &&
+           s->location_number<=it->location_number)
+        {
+          error().source_location=s->source_location;
+          error() << "thread creation in a loop is not supported, "
+                  << "unwind the loop first" << eom;
+          return true;
+        }
+    }
+
+    threads[t].instructions.swap(instructions);
+  }
+
+  return false;
+}
+
+void lazy_sequentializationt::collect_address_taken(
+  const exprt &expr,
+  bool address_of)
+{
+  if(expr.id()==ID_address_of)
+    address_of=true;
+  else if(expr.id()==ID_symbol && address_of)
+    address_taken.insert(to_symbol_expr(expr).get_identifier());
+
+  forall_operands(it, expr)
+    collect_address_taken(*it, address_of);
+}
+
+bool lazy_sequentializationt::is_shared(const exprt &expr) const
+{
+  if(expr.id()==ID_dereference)
+    return true;
+  else if(expr.id()==ID_symbol)
+  {
+    const irep_idt &identifier=to_symbol_expr(expr).get_identifier();
+
+    if(address_taken.find(identifier)!=address_taken.end())
+      return true;
+
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol))
+      return false;
+
+    return symbol->is_static_lifetime &&
+           !symbol->is_thread_local &&
+           symbol->type.id()!=ID_code;
+  }
+
+  forall_operands(it, expr)
+    if(is_shared(*it))
+      return true;
+
+  return false;
+}
+
+/// \return true if a context switch may be required before the
+///   instruction, i.e., it accesses shared state or begins an atomic
+///   section
+bool lazy_sequentializationt::is_visible(
+  const goto_programt::instructiont &instruction) const
+{
+  if(instruction.is_decl() || instruction.is_dead())
+    return false;
+  else if(instruction.is_atomic_begin())
+    return true;
+
+  return is_shared(instruction.code) || is_shared(instruction.guard);
+}
+
+void lazy_sequentializationt::build_renaming(std::size_t t)
+{
+  threadt &thread=threads[t];
+
+  find_symbols_sett used;
+  std::set<irep_idt> declared;
+
+  for(const auto &it : thread.instructions)
+  {
+    if(it->is_decl())
+      declared.insert(to_code_decl(it->code).get_identifier());
+
+    find_symbols(it->code, used);
+    find_symbols(it->guard, used);
+  }
+
+  for(const auto &identifier : used)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol) ||
+       symbol->is_type ||
+       symbol->is_macro ||
+       symbol->type.id()==ID_code)
+      continue;
+
+    if(!symbol->is_static_lifetime)
+    {
+      thread.renaming.insert(identifier, thread_copy(*symbol, t));
+
+      if(t!=0 && declared.find(identifier)==declared.end())
+        thread.captured.insert(identifier);
+    }
+    else if(symbol->is_thread_local && t!=0)
+    {
+      thread.renaming.insert(identifier, thread_copy(*symbol, t));
+      thread.thread_locals.insert(identifier);
+    }
+  }
+}
+
+void lazy_sequentializationt::build_thread_function(std::size_t t)
+{
+  threadt &thread=threads[t];
+
+  // the code of the thread, the exits at the switch points, and the end
+  goto_programt code, exits, end;
+
+  targett end_function=end.add_instruction(END_FUNCTION);
+  end_function->source_location=thread.instructions.back()->source_location;
+  end_function->function=thread.function;
+
+  std::vector<targett> resume;
+  std::map<targett, targett> target_map;
+  std::vector<targett> gotos;
+  bool atomic=false;
+
+  for(const auto &old : thread.instructions)
+  {
+    const goto_programt::instructiont &instruction=*old;
+    targett first=code.instructions.end();
+
+    if(!atomic && is_visible(instruction))
+    {
+      const std::size_t j=resume.size()+1;
+      const exprt j_expr=from_integer(j, thread.pc.type());
+
+      targett exit_pc=exits.add_instruction(ASSIGN);
+      exit_pc->code=code_assignt(thread.pc, j_expr);
+      exit_pc->source_location=instruction.source_location;
+      exit_pc->function=thread.function;
+
+      targett exit_goto=exits.add_instruction();
+      exit_goto->make_goto(end_function, true_exprt());
+      exit_goto->source_location=instruction.source_location;
+      exit_goto->function=thread.function;
+
+      first=code.add_instruction();
+      first->make_goto(
+        exit_pc,
+        binary_relation_exprt(next, ID_le, j_expr));
+      first->source_location=instruction.source_location;
+      first->function=instruction.function;
+
+      resume.push_back(first);
+    }
+
+    if(instruction.is_atomic_begin())
+      atomic=true;
+    else if(instruction.is_atomic_end())
+      atomic=false;
+
+    targett new_instruction;
+
+    if(instruction.is_start_thread())
+    {
+      const std::size_t c=created_thread[old];
+      const threadt &child=threads[c];
+
+      for(const auto &identifier : child.captured)
+      {
+        const symbolt &symbol=ns.lookup(identifier);
+        new_instruction=code.add_instruction(ASSIGN);
+        new_instruction->code=
+          code_assignt(thread_copy(symbol, c), thread_copy(symbol, t));
+        new_instruction->source_location=instruction.source_location;
+        new_instruction->function=instruction.function;
+
+        if(first==code.instructions.end())
+          first=new_instruction;
+      }
+
+      for(const auto &identifier : child.thread_locals)
+      {
+        const symbolt &symbol=ns.lookup(identifier);
+        exprt value=symbol.value;
+
+        if(value.is_nil())
+          value=zero_initializer(symbol.type, symbol.location, ns);
+
+        new_instruction=code.add_instruction(ASSIGN);
+        new_instruction->code=code_assignt(thread_copy(symbol, c), value);
+        new_instruction->source_location=instruction.source_location;
+        new_instruction->function=instruction.function;
+
+        if(first==code.instructions.end())
+          first=new_instruction;
+      }
+
+      new_instruction=code.add_instruction(ASSIGN);
+      new_instruction->code=code_assignt(child.active, true_exprt());
+      new_instruction->source_location=instruction.source_location;
+      new_instruction->function=instruction.function;
+    }
+    else if(instruction.is_end_thread() || instruction.is_end_function())
+    {
+      new_instruction=code.add_instruction(ASSIGN);
+      new_instruction->code=code_assignt(thread.active, false_exprt());
+      new_instruction->source_location=instruction.source_location;
+      new_instruction->function=instruction.function;
+
+      if(first==code.instructions.end())
+        first=new_instruction;
+
+      new_instruction=code.add_instruction();
+      new_instruction->make_goto(end_function, true_exprt());
+      new_instruction->source_location=instruction.source_location;
+      new_instruction->function=instruction.function;
+    }
+    else
+    {
+      new_instruction=code.add_instruction();
+      *new_instruction=instruction;
+      new_instruction->labels.clear();
+
+      thread.renaming(new_instruction->code);
+      thread.renaming(new_instruction->guard);
+
+      if(new_instruction->is_decl())
+      {
+        // the copies have static lifetime, declaring them havocs them
+        const exprt symbol=to_code_decl(new_instruction->code).symbol();
+        new_instruction->make_assignment();
+        new_instruction->code=
+          code_assignt(symbol, side_effect_expr_nondett(symbol.type()));
+      }
+      else if(new_instruction->is_dead() ||
+              new_instruction->is_atomic_begin() ||
+              new_instruction->is_atomic_end())
+        new_instruction->make_skip();
+      else if(new_instruction->is_goto())
+        gotos.push_back(new_instruction);
+    }
+
+    if(first==code.instructions.end())
+      first=new_instruction;
+
+    target_map[old]=first;
+  }
+
+  for(const auto &it : gotos)
+    for(auto &target : it->targets)
+    {
+      std::map<targett, targett>::const_iterator m_it=
+        target_map.find(target);
+      assert(m_it!=target_map.end());
+      target=m_it->second;
+    }
+
+  // next:=nondet, assume(next>=pc), and jump to the switch point
+  goto_programt &body=goto_functions.function_map[thread.function].body;
+  const source_locationt &source_location=thread.entry->source_location;
+
+  targett choose=body.add_instruction(ASSIGN);
+  choose->code=code_assignt(next, side_effect_expr_nondett(next.type()));
+  choose->source_location=source_location;
+  choose->function=thread.function;
+
+  targett assumption=body.add_instruction();
+  assumption->make_assumption(
+    binary_relation_exprt(next, ID_ge, thread.pc));
+  assumption->source_location=source_location;
+  assumption->function=thread.function;
+
+  for(std::size_t j=1; j<=resume.size(); j++)
+  {
+    targett jump=body.add_instruction();
+    jump->make_goto(
+      resume[j-1],
+      equal_exprt(thread.pc, from_integer(j, thread.pc.type())));
+    jump->source_location=source_location;
+    jump->function=thread.function;
+  }
+
+  body.destructive_append(code);
+  body.destructive_append(exits);
+  body.destructive_append(end);
+
+  switch_points+=resume.size();
+}
+
+bool lazy_sequentializationt::operator()(unsigned rounds)
+{
+  goto_functionst::function_mapt::iterator f_it=
+    goto_functions.function_map.find(goto_functions.entry_point());
+
+  if(f_it==goto_functions.function_map.end() ||
+     !f_it->second.body_available())
+  {
+    error() << "lazy sequentialization requires an entry point" << eom;
+    return true;
+  }
+
+  goto_programt &body=f_it->second.body;
+  body.update();
+
+  if(find_threads(body))
+    return true;
+
+  if(threads.size()==1)
+  {
+    status() << "No threads to sequentialize" << eom;
+    return false;
+  }
+
+  forall_goto_program_instructions(it, body)
+  {
+    collect_address_taken(it->code, false);
+    collect_address_taken(it->guard, false);
+  }
+
+  next=add_global(CPROVER_PREFIX "lazy_next", unsigned_int_type());
+
+  for(std::size_t t=0; t<threads.size(); t++)
+  {
+    threadt &thread=threads[t];
+    const std::string suffix=std::to_string(t);
+
+    thread.pc=add_global(
+      CPROVER_PREFIX "lazy_pc"+suffix, unsigned_int_type());
+    thread.active=add_global(
+      CPROVER_PREFIX "lazy_active"+suffix, bool_typet());
+
+    symbolt function_symbol;
+    function_symbol.name=CPROVER_PREFIX "lazy_thread"+suffix;
+    function_symbol.base_name=function_symbol.name;
+    function_symbol.pretty_name=function_symbol.name;
+    function_symbol.type=code_typet();
+    to_code_type(function_symbol.type).return_type()=empty_typet();
+    function_symbol.mode=ID_C;
+
+    thread.function=function_symbol.name;
+    goto_functions.function_map[thread.function].type=
+      to_code_type(function_symbol.type);
+
+    symbol_table.add(function_symbol);
+
+    build_renaming(t);
+  }
+
+  for(std::size_t t=0; t<threads.size(); t++)
+    build_thread_function(t);
+
+  // the driver calls the active threads round-robin
+  goto_programt driver;
+  const source_locationt &source_location=body.instructions.begin()->
+    source_location;
+
+  for(std::size_t t=0; t<threads.size(); t++)
+  {
+    targett init_pc=driver.add_instruction(ASSIGN);
+    init_pc->code=code_assignt(
+      threads[t].pc, from_integer(0, threads[t].pc.type()));
+    init_pc->source_location=source_location;
+    init_pc->function=f_it->first;
+
+    targett init_active=driver.add_instruction(ASSIGN);
+    init_active->code=code_assignt(
+      threads[t].active, t==0?exprt(true_exprt()):exprt(false_exprt()));
+    init_active->source_location=source_location;
+    init_active->function=f_it->first;
+  }
+
+  for(unsigned round=0; round<rounds; round++)
+    for(const auto &thread : threads)
+    {
+      targett skip_call=driver.add_instruction();
+      skip_call->source_location=source_location;
+      skip_call->function=f_it->first;
+
+      code_function_callt call;
+      call.function()=
+        symbol_exprt(thread.function, ns.lookup(thread.function).type);
+
+      targett call_instruction=driver.add_instruction(FUNCTION_CALL);
+      call_instruction->code=call;
+      call_instruction->source_location=source_location;
+      call_instruction->function=f_it->first;
+
+      targett after_call=driver.add_instruction(SKIP);
+      after_call->source_location=source_location;
+      after_call->function=f_it->first;
+
+      skip_call->make_goto(after_call, not_exprt(thread.active));
+    }
+
+  targett end_function=driver.add_instruction(END_FUNCTION);
+  end_function->source_location=body.instructions.back().source_location;
+  end_function->function=f_it->first;
+
+  body.swap(driver);
+
+  goto_functions.update();
+
+  status() << "Sequentialized " << threads.size() << " threads with "
+           << switch_points << " context-switch points for "
+           << rounds << " rounds" << eom;
+
+  return false;
+}
+
+bool lazy_sequentialization(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  unsigned rounds,
+  message_handlert &message_handler)
+{
+  lazy_sequentializationt lazy_sequentialization(
+    symbol_table, goto_functions, message_handler);
+  return lazy_sequentialization(rounds);
+}
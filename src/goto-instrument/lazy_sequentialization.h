@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Lazy Sequentialization of Threaded Goto Programs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Lazy Sequentialization of Threaded Goto Programs
+
+#ifndef CPROVER_GOTO_INSTRUMENT_LAZY_SEQUENTIALIZATION_H
+#define CPROVER_GOTO_INSTRUMENT_LAZY_SEQUENTIALIZATION_H
+
+class symbol_tablet;
+class goto_functionst;
+class message_handlert;
+
+/// Replaces the threads of a fully inlined program by a sequential
+/// program that runs them round-robin for the given number of rounds,
+/// with a possible context switch before each access to shared state.
+/// \return true on error
+bool lazy_sequentialization(
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  unsigned rounds,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_LAZY_SEQUENTIALIZATION_H
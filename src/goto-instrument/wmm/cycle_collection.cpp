@@ -13,6 +13,9 @@ Date: 2012
 
 #include "event_graph.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <util/message.h>
 
 /// after the collection, eliminates the executions forbidden by an indirect
@@ -47,6 +50,99 @@ void event_grapht::graph_explorert::filter_thin_air(
 #endif
 }
 
+/// computes the strongly connected components of the graph of po and com
+/// transitions, using an iterative version of Tarjan's algorithm
+void event_grapht::graph_explorert::compute_sccs()
+{
+  const std::size_t size=egraph.size();
+  const std::size_t unvisited=std::numeric_limits<std::size_t>::max();
+
+  std::vector<std::size_t> index(size, unvisited);
+  std::vector<std::size_t> lowlink(size, 0);
+  std::vector<bool> on_stack(size, false);
+  std::vector<event_idt> stack;
+  std::size_t next_index=0;
+  std::size_t next_scc=0;
+
+  scc.assign(size, unvisited);
+
+  /* successors of each event: po transitions first, then com */
+  std::vector<std::vector<event_idt> > successors(size);
+
+  for(event_idt v=0; v<size; v++)
+  {
+    for(const auto &edge : egraph.po_out(v))
+      successors[v].push_back(edge.first);
+    for(const auto &edge : egraph.com_out(v))
+      successors[v].push_back(edge.first);
+  }
+
+  /* frames of the depth-first search: event, next successor */
+  std::vector<std::pair<event_idt, std::size_t> > frames;
+
+  for(event_idt root=0; root<size; root++)
+  {
+    if(index[root]!=unvisited)
+      continue;
+
+    index[root]=lowlink[root]=next_index++;
+    stack.push_back(root);
+    on_stack[root]=true;
+    frames.push_back(std::make_pair(root, 0));
+
+    while(!frames.empty())
+    {
+      const event_idt v=frames.back().first;
+      const std::size_t position=frames.back().second;
+
+      if(position<successors[v].size())
+      {
+        frames.back().second++;
+        const event_idt w=successors[v][position];
+
+        if(index[w]==unvisited)
+        {
+          index[w]=lowlink[w]=next_index++;
+          stack.push_back(w);
+          on_stack[w]=true;
+          frames.push_back(std::make_pair(w, 0));
+        }
+        else if(on_stack[w])
+          lowlink[v]=std::min(lowlink[v], index[w]);
+
+        continue;
+      }
+
+      frames.pop_back();
+
+      if(!frames.empty())
+      {
+        const event_idt u=frames.back().first;
+        lowlink[u]=std::min(lowlink[u], lowlink[v]);
+      }
+
+      if(lowlink[v]==index[v])
+      {
+        event_idt w;
+
+        do
+        {
+          w=stack.back();
+          stack.pop_back();
+          on_stack[w]=false;
+          scc[w]=next_scc;
+        }
+        while(w!=v);
+
+        next_scc++;
+      }
+    }
+  }
+
+  egraph.message.debug() << next_scc << " SCCs in the event graph"
+                         << messaget::eom;
+}
+
 /// Tarjan 1972 adapted and modified for events
 void event_grapht::graph_explorert::collect_cycles(
   std::set<critical_cyclet> &set_of_cycles,
@@ -82,6 +178,8 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
+  compute_sccs();
+
   for(std::list<event_idt>::const_iterator
       st_it=order->begin();
       st_it!=order->end();
@@ -196,6 +294,10 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
+  /* no path from here leads back to the source */
+  if(!scc.empty() && scc[vertex]!=scc[source])
+    return false;
+
   egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
@@ -250,6 +250,11 @@ protected:
        to have all its events in this set */
     std::set<event_idt> thin_air_events;
 
+    /* strongly connected component of each event in the graph of po and
+       com transitions; a cycle never leaves the component of its source */
+    std::vector<std::size_t> scc;
+    void compute_sccs();
+
     /* after the collection, eliminates the executions forbidden by an
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
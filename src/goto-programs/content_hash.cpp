@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: Content Hashes of Goto Programs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Content Hashes of Goto Programs
+
+#include "content_hash.h"
+
+#include <map>
+#include <string>
+
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+
+std::size_t content_hasht::operator()(const irept &irep)
+{
+  std::unordered_map<const void *, std::size_t>::const_iterator entry=
+    hash_cache.find(&irep.read());
+
+  if(entry!=hash_cache.end())
+    return entry->second;
+
+  std::size_t result=hash_string(id2string(irep.id()));
+
+  forall_irep(it, irep.get_sub())
+    result=hash_combine(result, (*this)(*it));
+
+  // named_sub is ordered by string number, which varies between runs,
+  // hence combine these in the order of their names
+  std::map<std::string, std::size_t> named_sub_hashes;
+
+  forall_named_irep(it, irep.get_named_sub())
+    named_sub_hashes[id2string(it->first)]=(*this)(it->second);
+
+  if(with_comments)
+  {
+    forall_named_irep(it, irep.get_comments())
+      named_sub_hashes[id2string(it->first)]=(*this)(it->second);
+  }
+
+  for(const auto &named_sub_hash : named_sub_hashes)
+  {
+    result=hash_combine(result, hash_string(named_sub_hash.first));
+    result=hash_combine(result, named_sub_hash.second);
+  }
+
+  hash_cache[&irep.read()]=result;
+
+  return result;
+}
+
+std::size_t content_hasht::operator()(const goto_programt &goto_program)
+{
+  std::size_t result=0;
+
+  std::map<goto_programt::const_targett, std::size_t> numbers;
+
+  forall_goto_program_instructions(i_it, goto_program)
+    numbers.insert(std::make_pair(i_it, numbers.size()));
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    result=hash_combine(result, static_cast<std::size_t>(i_it->type));
+    result=hash_combine(result, (*this)(i_it->code));
+    result=hash_combine(result, (*this)(i_it->guard));
+
+    for(const auto &target : i_it->targets)
+      result=hash_combine(result, numbers[target]);
+  }
+
+  return result;
+}
+
+std::size_t content_hasht::operator()(
+  const goto_functionst::goto_functiont &goto_function)
+{
+  return hash_combine((*this)(goto_function.type),
+                      (*this)(goto_function.body));
+}
@@ -0,0 +1,42 @@
+/*******************************************************************\
+
+Module: Content Hashes of Goto Programs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Content Hashes of Goto Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_CONTENT_HASH_H
+#define CPROVER_GOTO_PROGRAMS_CONTENT_HASH_H
+
+#include <unordered_map>
+
+#include "goto_functions.h"
+
+/// A hash that, unlike irept::hash, does not depend on the order in which
+/// strings have been interned, and hence is the same in every run. This
+/// makes it suitable as a key of results stored across runs. Comments,
+/// e.g., source locations, are only included when asked for.
+class content_hasht
+{
+public:
+  explicit content_hasht(bool _with_comments=false):
+    with_comments(_with_comments)
+  {
+  }
+
+  std::size_t operator()(const irept &irep);
+  std::size_t operator()(const goto_programt &goto_program);
+  std::size_t operator()(const goto_functionst::goto_functiont &);
+
+protected:
+  const bool with_comments;
+
+  // memoized hashes of shared irep nodes
+  std::unordered_map<const void *, std::size_t> hash_cache;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_CONTENT_HASH_H
@@ -0,0 +1,159 @@
+/*******************************************************************\
+
+Module: Content Hashes of the Dependencies of a Function
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Content Hashes of the Dependencies of a Function
+
+#include "function_dependencies.h"
+
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <util/find_symbols.h>
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+
+static std::string to_hex(std::size_t h)
+{
+  std::ostringstream out;
+  out << std::hex << h;
+  return out.str();
+}
+
+void function_dependenciest::operator()(
+  const irep_idt &function,
+  hashest &dest)
+{
+  std::set<irep_idt> visited;
+  std::vector<irep_idt> worklist(1, function);
+  find_symbols_sett type_symbols;
+  bool indirect_call=false;
+
+  while(!worklist.empty())
+  {
+    const irep_idt identifier=worklist.back();
+    worklist.pop_back();
+
+    if(!visited.insert(identifier).second)
+      continue;
+
+    goto_functionst::function_mapt::const_iterator f_it=
+      goto_functions.function_map.find(identifier);
+
+    if(f_it==goto_functions.function_map.end())
+      continue;
+
+    const goto_functionst::goto_functiont &f=f_it->second;
+    const bool calls_followed=follow_calls(function, identifier, f);
+
+    dest[id2string(identifier)]=hash_function(f, calls_followed);
+
+    find_type_symbols(f.type, type_symbols);
+
+    if(!calls_followed)
+      continue;
+
+    forall_goto_program_instructions(i_it, f.body)
+    {
+      find_type_symbols(i_it->code, type_symbols);
+      find_type_symbols(i_it->guard, type_symbols);
+
+      if(!i_it->is_function_call())
+        continue;
+
+      const exprt &callee=to_code_function_call(i_it->code).function();
+
+      if(callee.id()==ID_symbol)
+        worklist.push_back(to_symbol_expr(callee).get_identifier());
+      else if(!indirect_call)
+      {
+        // an indirect call might reach anything
+        indirect_call=true;
+
+        forall_goto_functions(it, goto_functions)
+          worklist.push_back(it->first);
+      }
+    }
+  }
+
+  // the definitions of the types referenced, e.g., of structs
+  std::vector<irep_idt> type_worklist(
+    type_symbols.begin(), type_symbols.end());
+
+  while(!type_worklist.empty())
+  {
+    const irep_idt identifier=type_worklist.back();
+    type_worklist.pop_back();
+
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol))
+      continue;
+
+    dest[id2string(identifier)]=content_hash(symbol->type);
+
+    find_symbols_sett referenced;
+    find_type_symbols(symbol->type, referenced);
+
+    for(const auto &r : referenced)
+      if(type_symbols.insert(r).second)
+        type_worklist.push_back(r);
+  }
+}
+
+std::size_t function_dependenciest::hash_function(
+  const goto_functionst::goto_functiont &goto_function,
+  bool calls_followed)
+{
+  if(calls_followed)
+    return content_hash(goto_function);
+  else
+    return content_hash(goto_function.type);
+}
+
+std::string function_dependenciest::digest(const hashest &hashes)
+{
+  std::size_t h=0;
+
+  for(const auto &entry : hashes)
+  {
+    h=hash_combine(h, hash_string(entry.first));
+    h=hash_combine(h, entry.second);
+  }
+
+  return to_hex(h);
+}
+
+jsont function_dependenciest::to_json(const hashest &hashes)
+{
+  json_objectt json;
+
+  for(const auto &entry : hashes)
+    json[entry.first]=json_stringt(to_hex(entry.second));
+
+  return json;
+}
+
+bool function_dependenciest::from_json(const jsont &json, hashest &dest)
+{
+  if(!json.is_object())
+    return true;
+
+  for(const auto &entry : json.object)
+  {
+    std::istringstream in(entry.second.value);
+    std::size_t h;
+
+    if(!(in >> std::hex >> h))
+      return true;
+
+    dest[entry.first]=h;
+  }
+
+  return false;
+}
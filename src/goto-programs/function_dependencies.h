@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Content Hashes of the Dependencies of a Function
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Content Hashes of the Dependencies of a Function
+
+#ifndef CPROVER_GOTO_PROGRAMS_FUNCTION_DEPENDENCIES_H
+#define CPROVER_GOTO_PROGRAMS_FUNCTION_DEPENDENCIES_H
+
+#include <map>
+#include <string>
+
+#include <util/json.h>
+#include <util/namespace.h>
+
+#include "content_hash.h"
+
+/// Collects a function, the functions it may call, transitively, and the
+/// definitions of the types these use, each with its content_hasht. This
+/// is what a result that is computed for the function and stored across
+/// runs depends on. Two sets of dependencies are compared entry by entry,
+/// hence a result is only reused if every dependency is unchanged.
+class function_dependenciest
+{
+public:
+  // the content hash of each dependency, by name; ordered by the string,
+  // not by the irep_idt, such that the order is the same in every run
+  typedef std::map<std::string, std::size_t> hashest;
+
+  function_dependenciest(
+    const goto_functionst &_goto_functions,
+    const namespacet &_ns):
+    goto_functions(_goto_functions),
+    ns(_ns)
+  {
+  }
+
+  virtual ~function_dependenciest()
+  {
+  }
+
+  /// Adds \p function and everything it depends on to \p dest
+  void operator()(const irep_idt &function, hashest &dest);
+
+  /// \return a hash of the sequence of \p hashes, as a hex string
+  static std::string digest(const hashest &hashes);
+
+  static jsont to_json(const hashest &hashes);
+
+  /// \return true if \p json is not an object of hashes
+  static bool from_json(const jsont &json, hashest &dest);
+
+protected:
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+  content_hasht content_hash;
+
+  /// \return false if the callees of \p function do not matter for
+  ///   \p root; only the type of \p function is hashed then
+  virtual bool follow_calls(
+    const irep_idt &root,
+    const irep_idt &function,
+    const goto_functionst::goto_functiont &goto_function)
+  {
+    return true;
+  }
+
+  virtual std::size_t hash_function(
+    const goto_functionst::goto_functiont &goto_function,
+    bool calls_followed);
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_FUNCTION_DEPENDENCIES_H
@@ -217,6 +217,9 @@ static void rename_symbols_in_function(
   goto_functionst::goto_functiont &function,
   const rename_symbolt &rename_symbol)
 {
+  if(rename_symbol.empty())
+    return;
+
   goto_programt &program=function.body;
   rename_symbol(function.type);
 
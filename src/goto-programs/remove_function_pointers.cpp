@@ -42,6 +42,10 @@ public:
 
   void operator()(goto_functionst &goto_functions);
 
+  void operator()(
+    goto_functionst &goto_functions,
+    const function_pointer_targetst &function_pointer_targets);
+
   bool remove_function_pointers(goto_programt &goto_program);
 
 protected:
@@ -57,6 +61,10 @@ protected:
   // --remove-const-function-pointers instead of --remove-function-pointers
   bool only_resolve_const_fps;
 
+  // Targets of indirect calls as reported by a points-to analysis,
+  // if any. These are computed before any instruction is changed.
+  const function_pointer_targetst *known_targets;
+
   void remove_function_pointer(
     goto_programt &goto_program,
     goto_programt::targett target);
@@ -99,7 +107,8 @@ remove_function_pointerst::remove_function_pointerst(
   ns(_symbol_table),
   symbol_table(_symbol_table),
   add_safety_assertion(_add_safety_assertion),
-  only_resolve_const_fps(only_resolve_const_fps)
+  only_resolve_const_fps(only_resolve_const_fps),
+  known_targets(nullptr)
 {
   compute_address_taken_in_symbols(address_taken);
   compute_address_taken_functions(goto_functions, address_taken);
@@ -311,6 +320,26 @@ void remove_function_pointerst::remove_function_pointer(
     }
   }
 
+  if(!found_functions && known_targets!=nullptr)
+  {
+    function_pointer_targetst::const_iterator t_it=
+      known_targets->find(target);
+
+    if(t_it!=known_targets->end())
+    {
+      for(const auto &identifier : t_it->second)
+      {
+        type_mapt::const_iterator type_it=type_map.find(identifier);
+
+        if(type_it!=type_map.end())
+          functions.insert(symbol_exprt(identifier, type_it->second));
+      }
+
+      // no target at all is no information, rather than no call
+      found_functions=!functions.empty();
+    }
+  }
+
   if(!found_functions)
   {
     if(only_resolve_const_fps)
@@ -478,6 +507,15 @@ void remove_function_pointerst::operator()(goto_functionst &functions)
     functions.compute_location_numbers();
 }
 
+void remove_function_pointerst::operator()(
+  goto_functionst &functions,
+  const function_pointer_targetst &function_pointer_targets)
+{
+  known_targets=&function_pointer_targets;
+  (*this)(functions);
+  known_targets=nullptr;
+}
+
 bool remove_function_pointers(message_handlert &_message_handler,
   symbol_tablet &symbol_table,
   const goto_functionst &goto_functions,
@@ -514,6 +552,24 @@ void remove_function_pointers(
   rfp(goto_functions);
 }
 
+void remove_function_pointers(
+  message_handlert &_message_handler,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const function_pointer_targetst &function_pointer_targets,
+  bool add_safety_assertion)
+{
+  remove_function_pointerst
+    rfp(
+      _message_handler,
+      symbol_table,
+      add_safety_assertion,
+      false,
+      goto_functions);
+
+  rfp(goto_functions, function_pointer_targets);
+}
+
 void remove_function_pointers(message_handlert &_message_handler,
   goto_modelt &goto_model,
   bool add_safety_assertion,
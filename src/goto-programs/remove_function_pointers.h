@@ -14,9 +14,17 @@ Date: June 2003
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 
+#include <map>
+#include <set>
+
 #include "goto_model.h"
 #include <util/message.h>
 
+// the functions that indirect calls may call, as found by a points-to
+// analysis; calls with targets that are not known are left out
+typedef std::map<goto_programt::const_targett, std::set<irep_idt> >
+  function_pointer_targetst;
+
 // remove indirect function calls
 // and replace by case-split
 void remove_function_pointers(
@@ -32,6 +40,15 @@ void remove_function_pointers(
   bool add_safety_assertion,
   bool only_remove_const_fps=false);
 
+// remove indirect function calls, using the targets in
+// function_pointer_targets where these are known
+void remove_function_pointers(
+  message_handlert &_message_handler,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  const function_pointer_targetst &function_pointer_targets,
+  bool add_safety_assertion);
+
 bool remove_function_pointers(
   message_handlert &_message_handler,
   symbol_tablet &symbol_table,
@@ -52,6 +52,7 @@ protected:
 
   typedef std::vector<functiont> functionst;
   void get_functions(const exprt &, functionst &);
+  void restrict_to_receiver_types(const exprt &, functionst &) const;
   void get_child_functions_rec(
     const irep_idt &,
     const symbol_exprt &,
@@ -87,6 +88,7 @@ void remove_virtual_functionst::remove_virtual_function(
 
   functionst functions;
   get_functions(function, functions);
+  restrict_to_receiver_types(function, functions);
 
   if(functions.empty())
   {
@@ -302,6 +304,39 @@ void remove_virtual_functionst::get_functions(
     functions.push_back(root_function);
 }
 
+/// Drops the candidates that the receiver of the call cannot have, if the
+/// front-end has determined the classes of the receiver (ID_C_receiver_types).
+/// \par parameters: `function`: the virtual function called
+/// \return `functions` is filtered to the candidates of the receiver types.
+///   The last candidate, which the called class and its parents use, is
+///   kept if there is a receiver type without a candidate of its own.
+void remove_virtual_functionst::restrict_to_receiver_types(
+  const exprt &function,
+  functionst &functions) const
+{
+  const irept::subt &receiver_types=
+    function.find(ID_C_receiver_types).get_sub();
+
+  if(receiver_types.empty() || functions.empty())
+    return;
+
+  std::set<irep_idt> unmatched;
+  for(const auto &type : receiver_types)
+    unmatched.insert(type.id());
+
+  functionst result;
+  for(const auto &fun : functions)
+    if(unmatched.erase(fun.class_id))
+      result.push_back(fun);
+
+  if(!unmatched.empty() &&
+     (result.empty() ||
+      result.back().class_id!=functions.back().class_id))
+    result.push_back(functions.back());
+
+  functions.swap(result);
+}
+
 exprt remove_virtual_functionst::get_method(
   const irep_idt &class_id,
   const irep_idt &component_name) const
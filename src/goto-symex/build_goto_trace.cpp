@@ -160,11 +160,14 @@ void build_goto_trace(
 
       if(it->is_shared_read() || it->is_shared_write())
       {
-        // these are just used to get the time stamp
+        // these are just used to get the time stamp; events that are
+        // not subject to the partial order, e.g., on thread-local
+        // objects, have no clock and keep the current time
         exprt clock_value=prop_conv.get(
           symbol_exprt(partial_order_concurrencyt::rw_clock_id(it)));
 
-        to_integer(clock_value, current_time);
+        if(clock_value.is_constant())
+          to_integer(clock_value, current_time);
       }
       else if(it->is_atomic_end() && current_time<0)
         current_time*=-1;
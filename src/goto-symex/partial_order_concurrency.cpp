@@ -79,6 +79,72 @@ void partial_order_concurrencyt::build_event_lists(
 {
   add_init_writes(equation);
 
+  // Objects that only a single thread accesses once the first thread
+  // has been spawned cannot be subject to interference: any earlier
+  // access happens before the events of all other threads. These are
+  // taken out of the partial order, which saves the choice symbols and
+  // the clocks of their events.
+  std::map<irep_idt, unsigned> accessing_thread;
+  std::set<irep_idt> interfering_addresses;
+  bool spawn_seen=false;
+
+  for(eventst::const_iterator
+      e_it=equation.SSA_steps.begin();
+      e_it!=equation.SSA_steps.end();
+      e_it++)
+  {
+    if(e_it->is_spawn())
+      spawn_seen=true;
+
+    if(!e_it->is_shared_read() &&
+       !e_it->is_shared_write())
+      continue;
+
+    const irep_idt a=address(e_it);
+    a_rect &a_rec=address_map[a];
+
+    if(e_it->is_shared_read())
+      a_rec.reads.push_back(e_it);
+    else // must be write
+      a_rec.writes.push_back(e_it);
+
+    if(e_it->atomic_section_id!=0)
+      interfering_addresses.insert(a);
+    else if(spawn_seen)
+    {
+      const unsigned thread_nr=e_it->source.thread_nr;
+
+      if(!accessing_thread.insert(std::make_pair(a, thread_nr)).second &&
+         accessing_thread[a]!=thread_nr)
+        interfering_addresses.insert(a);
+    }
+  }
+
+  std::set<irep_idt> thread_local_addresses;
+  std::size_t thread_local_events=0;
+
+  for(address_mapt::iterator a_it=address_map.begin();
+      a_it!=address_map.end();
+      ) // no a_it++
+  {
+    if(interfering_addresses.find(a_it->first)!=
+       interfering_addresses.end())
+    {
+      a_it++;
+      continue;
+    }
+
+    thread_local_addresses.insert(a_it->first);
+    thread_local_events+=
+      a_it->second.reads.size()+a_it->second.writes.size();
+    a_it=address_map.erase(a_it);
+  }
+
+  thread_local_read_from(equation, thread_local_addresses);
+
+  statistics() << "Thread-local objects: " << thread_local_addresses.size()
+               << " (" << thread_local_events << " events)" << eom;
+
   // a per-thread counter
   std::map<unsigned, unsigned> counter;
 
@@ -88,25 +154,20 @@ void partial_order_concurrencyt::build_event_lists(
       e_it++)
   {
     if(e_it->is_shared_read() ||
-       e_it->is_shared_write() ||
-       e_it->is_spawn())
+       e_it->is_shared_write())
     {
-      unsigned thread_nr=e_it->source.thread_nr;
-
-      if(!e_it->is_spawn())
-      {
-        a_rect &a_rec=address_map[address(e_it)];
+      if(thread_local_addresses.find(address(e_it))!=
+         thread_local_addresses.end())
+        continue;
+    }
+    else if(!e_it->is_spawn())
+      continue;
 
-        if(e_it->is_shared_read())
-          a_rec.reads.push_back(e_it);
-        else // must be write
-          a_rec.writes.push_back(e_it);
-      }
+    unsigned thread_nr=e_it->source.thread_nr;
 
-      // maps an event id to a per-thread counter
-      unsigned cnt=counter[thread_nr]++;
-      numbering[e_it]=cnt;
-    }
+    // maps an event id to a per-thread counter
+    unsigned cnt=counter[thread_nr]++;
+    numbering[e_it]=cnt;
   }
 
   for(address_mapt::const_iterator
@@ -124,6 +185,57 @@ void partial_order_concurrencyt::build_event_lists(
   }
 }
 
+/// For objects that are not subject to interference, each read returns
+/// the value of the most recent write in the equation whose guard holds.
+/// This is encoded as an if-then-else over the preceding writes rather
+/// than by means of choice symbols and clocks.
+void partial_order_concurrencyt::thread_local_read_from(
+  symex_target_equationt &equation,
+  const std::set<irep_idt> &thread_local_addresses)
+{
+  if(thread_local_addresses.empty())
+    return;
+
+  // the value of the most recent write, per address
+  std::map<irep_idt, exprt> current_value;
+
+  for(eventst::const_iterator
+      e_it=equation.SSA_steps.begin();
+      e_it!=equation.SSA_steps.end();
+      e_it++)
+  {
+    if(!e_it->is_shared_read() &&
+       !e_it->is_shared_write())
+      continue;
+
+    const irep_idt a=address(e_it);
+
+    if(thread_local_addresses.find(a)==thread_local_addresses.end())
+      continue;
+
+    std::map<irep_idt, exprt>::iterator v_it=current_value.find(a);
+
+    if(e_it->is_shared_write())
+    {
+      if(v_it==current_value.end())
+        current_value.insert(std::make_pair(a, e_it->ssa_lhs));
+      else if(e_it->guard.is_true())
+        v_it->second=e_it->ssa_lhs;
+      else
+        v_it->second=if_exprt(e_it->guard, e_it->ssa_lhs, v_it->second);
+    }
+    else if(v_it!=current_value.end()) // must be read
+    {
+      // uninitialised objects, as in read_from, are left unconstrained
+      add_constraint(
+        equation,
+        implies_exprt(e_it->guard, equal_exprt(e_it->ssa_lhs, v_it->second)),
+        "rf-local",
+        e_it->source);
+    }
+  }
+}
+
 irep_idt partial_order_concurrencyt::rw_clock_id(
   event_it event,
   axiomt axiom)
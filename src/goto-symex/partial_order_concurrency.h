@@ -12,6 +12,8 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 #ifndef CPROVER_GOTO_SYMEX_PARTIAL_ORDER_CONCURRENCY_H
 #define CPROVER_GOTO_SYMEX_PARTIAL_ORDER_CONCURRENCY_H
 
+#include <set>
+
 #include <util/message.h>
 
 #include "symex_target_equation.h"
@@ -56,6 +58,11 @@ protected:
   void build_event_lists(symex_target_equationt &);
   void add_init_writes(symex_target_equationt &);
 
+  // encodes the reads of objects accessed by a single thread only
+  void thread_local_read_from(
+    symex_target_equationt &,
+    const std::set<irep_idt> &thread_local_addresses);
+
   // a per-thread numbering of the events
   typedef std::map<event_it, unsigned> numberingt;
   numberingt numbering;
@@ -24,14 +24,16 @@ void ci_lazy_methodst::add_needed_method(const irep_idt &method_symbol_name)
 
 /// Notes class `class_symbol_name` will be instantiated, or a static field
 /// belonging to it will be accessed. Also notes that its static initializer is
-/// therefore reachable.
+/// therefore reachable. The class is loaded if there is a class loader.
 /// \par parameters: `class_symbol_name`: class name; must exist in symbol
-///   table.
+///   table unless there is a class loader.
 /// \return Returns true if `class_symbol_name` is new (not seen before).
 bool ci_lazy_methodst::add_needed_class(const irep_idt &class_symbol_name)
 {
   if(!needed_classes.insert(class_symbol_name).second)
     return false;
+  if(class_loader!=nullptr)
+    class_loader->load_class(symbol_table, class_symbol_name);
   const irep_idt clinit_name(id2string(class_symbol_name)+".<clinit>:()V");
   if(symbol_table.symbols.count(clinit_name))
     add_needed_method(clinit_name);
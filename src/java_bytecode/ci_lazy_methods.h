@@ -16,16 +16,34 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 #include <set>
 #include <util/symbol_table.h>
 
+/// Loads classes into the symbol table when they are first needed, such
+/// that classes that no reachable method uses are never parsed
+class lazy_class_loadert
+{
+public:
+  virtual ~lazy_class_loadert()
+  {
+  }
+
+  /// Loads the class `class_symbol_name` (e.g., "java::A") into
+  /// `symbol_table`, unless it is there already
+  virtual void load_class(
+    symbol_tablet &symbol_table,
+    const irep_idt &class_symbol_name)=0;
+};
+
 class ci_lazy_methodst
 {
 public:
   ci_lazy_methodst(
     std::vector<irep_idt> &_needed_methods,
     std::set<irep_idt> &_needed_classes,
-    symbol_tablet &_symbol_table):
+    symbol_tablet &_symbol_table,
+    lazy_class_loadert *_class_loader=nullptr):
   needed_methods(_needed_methods),
   needed_classes(_needed_classes),
-  symbol_table(_symbol_table)
+  symbol_table(_symbol_table),
+  class_loader(_class_loader)
   {}
 
   void add_needed_method(const irep_idt &);
@@ -44,6 +62,8 @@ private:
   // repeatedly exploring a class hierarchy.
   std::set<irep_idt> &needed_classes;
   symbol_tablet &symbol_table;
+  // if given, needed classes are loaded through this
+  lazy_class_loadert *class_loader;
 };
 
 #endif
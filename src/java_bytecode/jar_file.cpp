@@ -31,14 +31,18 @@ void jar_filet::open(
     std::size_t number_of_files=
       mz_zip_reader_get_num_files(&zip);
 
+    // reused for all entries of the central directory
+    std::vector<char> filename_buffer;
+
     for(std::size_t i=0; i<number_of_files; i++)
     {
       mz_uint filename_length=mz_zip_reader_get_filename(&zip, i, nullptr, 0);
-      char *filename_char=new char[filename_length+1];
+      filename_buffer.resize(filename_length+1);
       mz_uint filename_len=
-        mz_zip_reader_get_filename(&zip, i, filename_char, filename_length);
+        mz_zip_reader_get_filename(
+          &zip, i, filename_buffer.data(), filename_length);
       assert(filename_length==filename_len);
-      std::string file_name(filename_char);
+      std::string file_name(filename_buffer.data());
 
       // non-class files are loaded in any case
       bool add_file=!has_suffix(file_name, ".class");
@@ -46,12 +50,12 @@ void jar_filet::open(
       add_file|=class_loader_limit.load_class_file(file_name);
       if(add_file)
       {
+        // there may be many thousands of these
         if(has_suffix(file_name, ".class"))
-          status() << "read class file " << file_name
-                   << " from " << filename << eom;
+          debug() << "read class file " << file_name
+                  << " from " << filename << eom;
         filtered_jar[file_name]=i;
       }
-      delete[] filename_char;
     }
   }
 }
@@ -81,16 +85,14 @@ std::string jar_filet::get_entry(const irep_idt &name)
   mz_bool stat_ok=mz_zip_reader_file_stat(&zip, real_index, &file_stat);
   if(stat_ok!=MZ_TRUE)
     return std::string();
-  std::vector<char> buffer;
+  // inflate directly into the result
   size_t bufsize=file_stat.m_uncomp_size;
-  buffer.resize(bufsize);
+  dest.resize(bufsize);
   mz_bool read_ok=
-    mz_zip_reader_extract_to_mem(&zip, real_index, buffer.data(), bufsize, 0);
+    mz_zip_reader_extract_to_mem(&zip, real_index, &dest[0], bufsize, 0);
   if(read_ok!=MZ_TRUE)
     return std::string();
 
-  dest.insert(dest.end(), buffer.begin(), buffer.end());
-
   return dest;
 }
 
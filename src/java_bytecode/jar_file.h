@@ -69,7 +69,7 @@ public:
       return jar_file;
     }
     else
-      return file_map[file_name];
+      return it->second;
   }
 
 protected:
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "java_types.h"
 #include "java_bytecode_convert_method.h"
 #include "java_bytecode_language.h"
+#include "java_method_cache.h"
 
 #include <util/c_types.h>
 #include <util/namespace.h>
@@ -36,14 +37,16 @@ public:
     lazy_methodst& _lazy_methods,
     lazy_methods_modet _lazy_methods_mode,
     bool _string_refinement_enabled,
-    const character_refine_preprocesst &_character_preprocess):
+    const character_refine_preprocesst &_character_preprocess,
+    java_method_cachet *_method_cache):
     messaget(_message_handler),
     symbol_table(_symbol_table),
     max_array_length(_max_array_length),
     lazy_methods(_lazy_methods),
     lazy_methods_mode(_lazy_methods_mode),
     string_refinement_enabled(_string_refinement_enabled),
-    character_preprocess(_character_preprocess)
+    character_preprocess(_character_preprocess),
+    method_cache(_method_cache)
   {
   }
 
@@ -70,6 +73,7 @@ protected:
   lazy_methods_modet lazy_methods_mode;
   bool string_refinement_enabled;
   character_refine_preprocesst character_preprocess;
+  java_method_cachet *method_cache;
 
   // conversion
   void convert(const classt &c);
@@ -157,13 +161,21 @@ void java_bytecode_convert_classt::convert(const classt &c)
     if(lazy_methods_mode==LAZY_METHODS_MODE_EAGER)
     {
       // Upgrade to a fully-realized symbol now:
-      java_bytecode_convert_method(
-        *class_symbol,
-        method,
-        symbol_table,
-        get_message_handler(),
-        max_array_length,
-        character_preprocess);
+      if(method_cache!=nullptr)
+        method_cache->convert_method(
+          *class_symbol,
+          method,
+          symbol_table,
+          safe_pointer<ci_lazy_methodst>::create_null(),
+          character_preprocess);
+      else
+        java_bytecode_convert_method(
+          *class_symbol,
+          method,
+          symbol_table,
+          get_message_handler(),
+          max_array_length,
+          character_preprocess);
     }
     else
     {
@@ -315,7 +327,8 @@ bool java_bytecode_convert_class(
   lazy_methodst &lazy_methods,
   lazy_methods_modet lazy_methods_mode,
   bool string_refinement_enabled,
-  const character_refine_preprocesst &character_preprocess)
+  const character_refine_preprocesst &character_preprocess,
+  java_method_cachet *method_cache)
 {
   java_bytecode_convert_classt java_bytecode_convert_class(
     symbol_table,
@@ -324,7 +337,8 @@ bool java_bytecode_convert_class(
     lazy_methods,
     lazy_methods_mode,
     string_refinement_enabled,
-    character_preprocess);
+    character_preprocess,
+    method_cache);
 
   try
   {
@@ -19,6 +19,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "java_bytecode_language.h"
 #include "character_refine_preprocess.h"
 
+class java_method_cachet;
+
+/// \param method_cache: if not null, methods converted eagerly are taken
+///   from and stored in this cache
 bool java_bytecode_convert_class(
   const java_bytecode_parse_treet &parse_tree,
   symbol_tablet &symbol_table,
@@ -27,6 +31,7 @@ bool java_bytecode_convert_class(
   lazy_methodst &,
   lazy_methods_modet,
   bool string_refinement_enabled,
-  const character_refine_preprocesst &character_preprocess);
+  const character_refine_preprocesst &character_preprocess,
+  java_method_cachet *method_cache=nullptr);
 
 #endif // CPROVER_JAVA_BYTECODE_JAVA_BYTECODE_CONVERT_CLASS_H
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/suffix.h>
 #include <util/config.h>
 #include <util/cmdline.h>
+#include <util/find_symbols.h>
+#include <util/prefix.h>
 #include <util/string2int.h>
 #include <json/json_parser.h>
 
@@ -26,6 +28,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "java_entry_point.h"
 #include "java_bytecode_parser.h"
 #include "java_class_loader.h"
+#include "java_receiver_types.h"
 
 #include "expr2java.h"
 
@@ -48,6 +51,9 @@ void java_bytecode_languaget::get_language_options(const cmdlinet &cmd)
   else
     lazy_methods_mode=LAZY_METHODS_MODE_EAGER;
 
+  if(cmd.isset("java-method-cache"))
+    java_method_cache_file=cmd.get_value("java-method-cache");
+
   if(cmd.isset("java-cp-include-files"))
   {
     java_cp_include_files=cmd.get_value("java-cp-include-files");
@@ -147,7 +153,13 @@ bool java_bytecode_languaget::parse(
   if(!main_class.empty())
   {
     status() << "Java main class: " << main_class << eom;
-    java_class_loader(main_class);
+
+    // with lazy methods, the classes the main class refers to are only
+    // loaded once they are needed, see load_class
+    if(lazy_methods_mode==LAZY_METHODS_MODE_EAGER)
+      java_class_loader(main_class);
+    else
+      java_class_loader.load_main_class(main_class);
   }
 
   return false;
@@ -266,6 +278,53 @@ static void get_virtual_method_targets(
   }
 }
 
+/// Find the callees of a virtual call whose receiver types are known at the
+/// call site (see annotate_receiver_types).
+/// \par parameters: `c`: function call whose potential target functions should
+///   be determined.
+/// `symbol_table`: global symtab
+/// `class_hierarchy`: global class hierarchy
+/// \return Populates `needed_methods` with the definition of the called
+///   function that each receiver type uses. Returns false if the receiver
+///   types of `c` are not known.
+static bool get_receiver_type_targets(
+  const code_function_callt &c,
+  std::vector<irep_idt> &needed_methods,
+  const symbol_tablet &symbol_table,
+  const class_hierarchyt &class_hierarchy)
+{
+  const std::set<irep_idt> receiver_types=get_receiver_types(c);
+  if(receiver_types.empty())
+    return false;
+
+  const auto &call_basename=c.function().get(ID_component_name);
+  const auto old_size=needed_methods.size();
+
+  for(const auto &receiver_type : receiver_types)
+  {
+    // Use the most-derived definition, as the dispatch does
+    irep_idt class_id=receiver_type;
+    while(!class_id.empty())
+    {
+      const irep_idt methodid=
+        id2string(class_id)+"."+id2string(call_basename);
+      if(symbol_table.has_symbol(methodid))
+      {
+        needed_methods.push_back(methodid);
+        break;
+      }
+
+      auto findit=class_hierarchy.class_map.find(class_id);
+      if(findit==class_hierarchy.class_map.end() ||
+         findit->second.parents.empty())
+        break;
+      class_id=findit->second.parents[0];
+    }
+  }
+
+  return needed_methods.size()!=old_size;
+}
+
 /// See output
 /// \par parameters: `e`: expression tree to search
 /// \return Populates `result` with pointers to each function call within e that
@@ -392,6 +451,18 @@ bool java_bytecode_languaget::typecheck(
   if(string_refinement_enabled)
     character_preprocess.initialize_conversion_table();
 
+  if(!java_method_cache_file.empty() && !method_cache)
+  {
+    method_cache=std::unique_ptr<java_method_cachet>(
+      new java_method_cachet(
+        get_message_handler(),
+        max_user_array_length,
+        string_refinement_enabled));
+
+    if(method_cache->read(java_method_cache_file))
+      return true;
+  }
+
   // first convert all
   for(java_class_loadert::class_mapt::const_iterator
       c_it=java_class_loader.class_map.begin();
@@ -411,19 +482,32 @@ bool java_bytecode_languaget::typecheck(
          lazy_methods,
          lazy_methods_mode,
          string_refinement_enabled,
-         character_preprocess))
+         character_preprocess,
+         method_cache.get()))
       return true;
   }
 
   // Now incrementally elaborate methods
   // that are reachable from this entry point.
-  if(lazy_methods_mode==LAZY_METHODS_MODE_CONTEXT_INSENSITIVE)
+  if(lazy_methods_mode==LAZY_METHODS_MODE_CONTEXT_INSENSITIVE ||
+     lazy_methods_mode==LAZY_METHODS_MODE_CONTEXT_SENSITIVE)
   {
-    // ci: context-insensitive.
+    // ci: context-insensitive; the context-sensitive mode additionally
+    // uses the receiver types known at the call sites.
     if(do_ci_lazy_method_conversion(symbol_table, lazy_methods))
       return true;
   }
 
+  if(method_cache)
+  {
+    status() << "Java method cache: "
+             << method_cache->number_of_hits() << " hits, "
+             << method_cache->number_of_misses() << " misses" << eom;
+
+    if(write_method_cache())
+      return true;
+  }
+
   // now typecheck all
   if(java_bytecode_typecheck(
        symbol_table, get_message_handler(), string_refinement_enabled))
@@ -438,7 +522,8 @@ bool java_bytecode_languaget::typecheck(
 /// methods are reachable if we find a virtual callsite targeting a compatible
 /// type *and* a constructor callsite indicating an object of that type may be
 /// instantiated (or evidence that an object of that type exists before the main
-/// function is entered, such as being passed as a parameter).
+/// function is entered, such as being passed as a parameter). Classes beyond
+/// the main class are loaded as they are needed, see load_class.
 /// \par parameters: `symbol_table`: global symbol table
 /// `lazy_methods`: map from method names to relevant symbol and parsed-method
 ///   objects.
@@ -449,9 +534,6 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
   symbol_tablet &symbol_table,
   lazy_methodst &lazy_methods)
 {
-  class_hierarchyt ch;
-  ch(symbol_table);
-
   std::vector<irep_idt> method_worklist1;
   std::vector<irep_idt> method_worklist2;
 
@@ -481,14 +563,26 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
   else
     method_worklist2.push_back(main_function.main_function.name);
 
+  // the types of the parameters of the entry points
+  for(const auto &mname : method_worklist2)
+  {
+    auto findit=lazy_methods.find(mname);
+    if(findit!=lazy_methods.end())
+      load_class_refs(symbol_table, *findit->second.first);
+  }
+
   std::set<irep_idt> needed_classes;
 
   {
+    class_hierarchyt ch;
+    ch(symbol_table);
+
     std::vector<irep_idt> needed_clinits;
     ci_lazy_methodst initial_lazy_methods(
       needed_clinits,
       needed_classes,
-      symbol_table);
+      symbol_table,
+      this);
     initialize_needed_classes(
       method_worklist2,
       namespacet(symbol_table),
@@ -522,19 +616,18 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
         }
         debug() << "CI lazy methods: elaborate " << mname << eom;
         const auto &parsed_method=findit->second;
+        load_class_refs(symbol_table, *parsed_method.first);
         // Note this wraps *references* to method_worklist2, needed_classes:
         ci_lazy_methodst lazy_methods(
           method_worklist2,
           needed_classes,
-          symbol_table);
-        java_bytecode_convert_method(
+          symbol_table,
+          this);
+        convert_method(
           *parsed_method.first,
           *parsed_method.second,
           symbol_table,
-          get_message_handler(),
-          max_user_array_length,
-          safe_pointer<ci_lazy_methodst>::create_non_null(&lazy_methods),
-          character_preprocess);
+          safe_pointer<ci_lazy_methodst>::create_non_null(&lazy_methods));
         gather_virtual_callsites(
           symbol_table.lookup(mname).value,
           virtual_callsites);
@@ -551,8 +644,20 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
             << " callsites)"
             << eom;
 
+    // classes may have been loaded since the last round
+    class_hierarchyt ch;
+    ch(symbol_table);
+
     for(const auto &callsite : virtual_callsites)
     {
+      if(lazy_methods_mode==LAZY_METHODS_MODE_CONTEXT_SENSITIVE &&
+         get_receiver_type_targets(
+           *callsite,
+           method_worklist2,
+           symbol_table,
+           ch))
+        continue;
+
       // This will also create a stub if a virtual callsite has no targets.
       get_virtual_method_targets(
         *callsite,
@@ -564,6 +669,9 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
   }
   while(any_new_methods);
 
+  load_referenced_classes(
+    symbol_table, lazy_methods, methods_already_populated);
+
   // Remove symbols for methods that were declared but never used:
   symbol_tablet keep_symbols;
 
@@ -591,6 +699,111 @@ bool java_bytecode_languaget::do_ci_lazy_method_conversion(
   return false;
 }
 
+/// Parses and converts the class `class_symbol_name` and the classes it
+/// extends or implements, unless it is in the symbol table already. With
+/// lazy methods, this is how classes other than the main class are loaded.
+/// \par parameters: `symbol_table`: global symbol table
+/// `class_symbol_name`: class name, e.g., "java::A"
+void java_bytecode_languaget::load_class(
+  symbol_tablet &symbol_table,
+  const irep_idt &class_symbol_name)
+{
+  if(symbol_table.has_symbol(class_symbol_name) ||
+     !has_prefix(id2string(class_symbol_name), "java::"))
+    return;
+
+  const irep_idt class_name=id2string(class_symbol_name).substr(6);
+
+  for(const auto &c : java_class_loader.load_class(class_name))
+  {
+    const java_bytecode_parse_treet &parse_tree=
+      java_class_loader.class_map.at(c);
+
+    // not found on the classpath
+    if(parse_tree.parsed_class.name.empty())
+      continue;
+
+    debug() << "Converting class " << c << eom;
+
+    if(java_bytecode_convert_class(
+         parse_tree,
+         symbol_table,
+         get_message_handler(),
+         max_user_array_length,
+         lazy_methods,
+         lazy_methods_mode,
+         string_refinement_enabled,
+         character_preprocess,
+         method_cache.get()))
+      throw 0;
+  }
+}
+
+/// Loads the classes that the methods of `class_symbol` refer to, which
+/// need to be there before one of these methods is converted
+void java_bytecode_languaget::load_class_refs(
+  symbol_tablet &symbol_table,
+  const symbolt &class_symbol)
+{
+  const auto c_it=java_class_loader.class_map.find(class_symbol.base_name);
+  if(c_it==java_class_loader.class_map.end())
+    return;
+
+  for(const auto &class_ref : c_it->second.class_refs)
+    load_class(symbol_table, "java::"+id2string(class_ref));
+}
+
+/// Loads the classes that remaining symbols only refer to as a type, e.g.,
+/// by the type of a field, such that all types are defined. Their methods
+/// are not elaborated.
+/// \par parameters: `symbol_table`: global symbol table
+/// `lazy_methods`: map from method names to relevant symbol and parsed-method
+///   objects.
+/// `methods_already_populated`: the methods that have been elaborated
+void java_bytecode_languaget::load_referenced_classes(
+  symbol_tablet &symbol_table,
+  const lazy_methodst &lazy_methods,
+  const std::set<irep_idt> &methods_already_populated)
+{
+  std::set<irep_idt> attempted;
+  bool first_round=true;
+
+  while(true)
+  {
+    find_symbols_sett type_symbols;
+
+    for(const auto &sym : symbol_table.symbols)
+    {
+      // after the first round, only the types of new classes matter
+      if(!first_round && !sym.second.is_type)
+        continue;
+      // the types of static fields also occur where the fields are used
+      if(sym.second.is_static_lifetime)
+        continue;
+      if(lazy_methods.count(sym.first) &&
+         !methods_already_populated.count(sym.first))
+        continue;
+
+      find_type_symbols(sym.second.type, type_symbols);
+      find_type_symbols(sym.second.value, type_symbols);
+    }
+
+    first_round=false;
+    bool loaded=false;
+
+    for(const auto &identifier : type_symbols)
+      if(!symbol_table.has_symbol(identifier) &&
+         attempted.insert(identifier).second)
+      {
+        load_class(symbol_table, identifier);
+        loaded=true;
+      }
+
+    if(!loaded)
+      break;
+  }
+}
+
 /// Provide feedback to `language_filest` so that when asked for a lazy method,
 /// it can delegate to this instance of java_bytecode_languaget.
 /// \return Populates `methods` with the complete list of lazy methods that are
@@ -617,13 +830,55 @@ void java_bytecode_languaget::convert_lazy_method(
   symbol_tablet &symtab)
 {
   const auto &lazy_method_entry=lazy_methods.at(id);
-  java_bytecode_convert_method(
+  convert_method(
     *lazy_method_entry.first,
     *lazy_method_entry.second,
     symtab,
-    get_message_handler(),
-    max_user_array_length,
-    character_preprocess);
+    safe_pointer<ci_lazy_methodst>::create_null());
+}
+
+/// Converts a method, using the method cache if there is one
+void java_bytecode_languaget::convert_method(
+  const symbolt &class_symbol,
+  const java_bytecode_parse_treet::methodt &method,
+  symbol_tablet &symbol_table,
+  safe_pointer<ci_lazy_methodst> lazy_methods)
+{
+  if(method_cache)
+    method_cache->convert_method(
+      class_symbol,
+      method,
+      symbol_table,
+      lazy_methods,
+      character_preprocess);
+  else
+    java_bytecode_convert_method(
+      class_symbol,
+      method,
+      symbol_table,
+      get_message_handler(),
+      max_user_array_length,
+      lazy_methods,
+      character_preprocess);
+
+  if(lazy_methods_mode==LAZY_METHODS_MODE_CONTEXT_SENSITIVE)
+  {
+    const irep_idt method_identifier=
+      id2string(class_symbol.name)+"."+id2string(method.name)+":"+
+      method.signature;
+    annotate_receiver_types(
+      symbol_table.symbols.find(method_identifier)->second);
+  }
+}
+
+/// Writes the method cache back to its file if anything was added to it
+/// \return true on error
+bool java_bytecode_languaget::write_method_cache()
+{
+  if(!method_cache || !method_cache->is_modified())
+    return false;
+
+  return method_cache->write(java_method_cache_file);
 }
 
 bool java_bytecode_languaget::final(symbol_tablet &symbol_table)
@@ -633,6 +888,9 @@ bool java_bytecode_languaget::final(symbol_tablet &symbol_table)
   */
   java_internal_additions(symbol_table);
 
+  // methods converted lazily since typecheck are added to the cache
+  if(write_method_cache())
+    return true;
 
   main_function_resultt res=
     get_main_symbol(symbol_table, main_class, get_message_handler());
@@ -10,10 +10,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_JAVA_BYTECODE_JAVA_BYTECODE_LANGUAGE_H
 #define CPROVER_JAVA_BYTECODE_JAVA_BYTECODE_LANGUAGE_H
 
+#include <memory>
+
 #include <util/language.h>
 #include <util/cmdline.h>
 
+#include "ci_lazy_methods.h"
 #include "java_class_loader.h"
+#include "java_method_cache.h"
 #include "character_refine_preprocess.h"
 
 #define MAX_NONDET_ARRAY_LENGTH_DEFAULT 5
@@ -34,7 +38,9 @@ typedef std::pair<
 typedef std::map<irep_idt, lazy_method_valuet>
   lazy_methodst;
 
-class java_bytecode_languaget:public languaget
+class java_bytecode_languaget:
+  public languaget,
+  public lazy_class_loadert
 {
 public:
   virtual void get_language_options(const cmdlinet &) override;
@@ -94,8 +100,17 @@ public:
   virtual void convert_lazy_method(
     const irep_idt &id, symbol_tablet &) override;
 
+  void load_class(
+    symbol_tablet &symbol_table,
+    const irep_idt &class_symbol_name) override;
+
 protected:
   bool do_ci_lazy_method_conversion(symbol_tablet &, lazy_methodst &);
+  void load_class_refs(symbol_tablet &, const symbolt &class_symbol);
+  void load_referenced_classes(
+    symbol_tablet &,
+    const lazy_methodst &,
+    const std::set<irep_idt> &methods_already_populated);
 
   irep_idt main_class;
   std::vector<irep_idt> main_jar_classes;
@@ -108,6 +123,15 @@ protected:
   bool string_refinement_enabled;
   character_refine_preprocesst character_preprocess;
   std::string java_cp_include_files;
+  std::string java_method_cache_file;
+  std::unique_ptr<java_method_cachet> method_cache;
+
+  void convert_method(
+    const symbolt &class_symbol,
+    const java_bytecode_parse_treet::methodt &,
+    symbol_tablet &,
+    safe_pointer<ci_lazy_methodst> lazy_methods);
+  bool write_method_cache();
 };
 
 languaget *new_java_bytecode_language();
@@ -61,6 +61,54 @@ java_bytecode_parse_treet &java_class_loadert::operator()(
   return class_map[class_name];
 }
 
+java_bytecode_parse_treet &java_class_loadert::load_main_class(
+  const irep_idt &class_name)
+{
+  // always required, see operator()
+  load_class("java.lang.Object");
+  load_class("java.lang.String");
+  load_class("java.lang.Class");
+  load_class(class_name);
+
+  return class_map[class_name];
+}
+
+std::vector<irep_idt> java_class_loadert::load_class(
+  const irep_idt &class_name)
+{
+  std::vector<irep_idt> result;
+  std::stack<irep_idt> queue;
+  queue.push(class_name);
+
+  java_class_loader_limitt class_loader_limit(
+    get_message_handler(), java_cp_include_files);
+
+  while(!queue.empty())
+  {
+    irep_idt c=queue.top();
+    queue.pop();
+
+    // do we have the class already?
+    if(class_map.find(c)!=class_map.end())
+      continue; // got it already
+
+    debug() << "Reading class " << c << eom;
+
+    const java_bytecode_parse_treet::classt &parsed_class=
+      get_parse_tree(class_loader_limit, c).parsed_class;
+    result.push_back(c);
+
+    // the bases are needed to convert the class
+    if(!parsed_class.extends.empty())
+      queue.push(parsed_class.extends);
+
+    for(const auto &interface : parsed_class.implements)
+      queue.push(interface);
+  }
+
+  return result;
+}
+
 void java_class_loadert::set_java_cp_include_files(
   std::string &_java_cp_include_files)
 {
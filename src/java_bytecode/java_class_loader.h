@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <regex>
 #include <set>
+#include <vector>
 
 #include <util/message.h>
 
@@ -25,6 +26,15 @@ class java_class_loadert:public messaget
 public:
   java_bytecode_parse_treet &operator()(const irep_idt &);
 
+  /// Like operator(), but does not parse the classes that \p class_name
+  /// refers to; these are left to load_class
+  java_bytecode_parse_treet &load_main_class(const irep_idt &class_name);
+
+  /// Parses \p class_name and the classes it extends or implements, unless
+  /// they have been parsed already, but not the other classes they refer to
+  /// \return the classes that were parsed, in no particular order
+  std::vector<irep_idt> load_class(const irep_idt &class_name);
+
   void set_java_cp_include_files(std::string &);
 
   // maps class names to the parse trees
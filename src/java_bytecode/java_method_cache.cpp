@@ -0,0 +1,292 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Converted Java Methods
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Converted Java Methods
+
+#include "java_method_cache.h"
+
+#include <cassert>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+
+#include <goto-programs/content_hash.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include "java_bytecode_convert_method.h"
+
+// bump this whenever the conversion or the format of the file changes
+static const char cache_version[]="1";
+
+// prefix of the symbols that hold the cache entries in the goto binary
+static const char entry_prefix[]="java_method_cache::";
+
+java_method_cachet::java_method_cachet(
+  message_handlert &_message_handler,
+  size_t _max_array_length,
+  bool _string_refinement_enabled):
+  messaget(_message_handler),
+  max_array_length(_max_array_length),
+  string_refinement_enabled(_string_refinement_enabled),
+  hits(0),
+  misses(0),
+  modified(false)
+{
+}
+
+std::string java_method_cachet::compute_key(
+  const symbolt &class_symbol,
+  const java_bytecode_parse_treet::methodt &method,
+  const symbolt &method_symbol,
+  bool lazy)
+{
+  // The conversion uses comments, e.g., the class of a call target and
+  // the source locations, hence these are included.
+  content_hasht content_hash(true);
+
+  std::size_t h=hash_string(cache_version);
+  h=hash_combine(h, max_array_length);
+  h=hash_combine(h, string_refinement_enabled);
+  h=hash_combine(h, lazy);
+
+  h=hash_combine(h, hash_string(id2string(class_symbol.name)));
+  h=hash_combine(h, hash_string(id2string(class_symbol.base_name)));
+  h=hash_combine(h, hash_string(id2string(class_symbol.pretty_name)));
+  h=hash_combine(h, content_hash(method_symbol.type));
+
+  h=hash_combine(h, hash_string(id2string(method.name)));
+  h=hash_combine(h, hash_string(id2string(method.base_name)));
+  h=hash_combine(h, hash_string(method.signature));
+  h=hash_combine(h, content_hash(method.source_location));
+  h=hash_combine(h, method.is_public);
+  h=hash_combine(h, method.is_protected);
+  h=hash_combine(h, method.is_private);
+  h=hash_combine(h, method.is_static);
+  h=hash_combine(h, method.is_final);
+  h=hash_combine(h, method.is_native);
+  h=hash_combine(h, method.is_abstract);
+  h=hash_combine(h, method.is_synchronized);
+
+  for(const auto &instruction : method.instructions)
+  {
+    h=hash_combine(h, instruction.address);
+    h=hash_combine(h, hash_string(id2string(instruction.statement)));
+    h=hash_combine(h, content_hash(instruction.source_location));
+
+    for(const auto &arg : instruction.args)
+      h=hash_combine(h, content_hash(arg));
+  }
+
+  for(const auto &exception : method.exception_table)
+  {
+    h=hash_combine(h, exception.start_pc);
+    h=hash_combine(h, exception.end_pc);
+    h=hash_combine(h, exception.handler_pc);
+    h=hash_combine(h, content_hash(exception.catch_type));
+  }
+
+  for(const auto &variable : method.local_variable_table)
+  {
+    h=hash_combine(h, hash_string(id2string(variable.name)));
+    h=hash_combine(h, hash_string(variable.signature));
+    h=hash_combine(h, variable.index);
+    h=hash_combine(h, variable.start_pc);
+    h=hash_combine(h, variable.length);
+  }
+
+  std::ostringstream key;
+  key << std::hex << h;
+  return key.str();
+}
+
+void java_method_cachet::convert_method(
+  const symbolt &class_symbol,
+  const java_bytecode_parse_treet::methodt &method,
+  symbol_tablet &symbol_table,
+  safe_pointer<ci_lazy_methodst> lazy_methods,
+  const character_refine_preprocesst &character_refine)
+{
+  const irep_idt method_identifier=
+    id2string(class_symbol.name)+"."+id2string(method.name)+":"+
+    method.signature;
+
+  const std::string key=
+    compute_key(
+      class_symbol,
+      method,
+      symbol_table.lookup(method_identifier),
+      lazy_methods);
+
+  entriest::const_iterator e_it=entries.find(method_identifier);
+
+  if(e_it!=entries.end() && e_it->second.key==key)
+  {
+    hits++;
+    apply(method_identifier, e_it->second, symbol_table, lazy_methods);
+    return;
+  }
+
+  misses++;
+
+  // Convert in a symbol table of its own, such that we see all the
+  // symbols the conversion adds, not just the ones that are new here.
+  symbol_tablet method_symbol_table;
+  method_symbol_table.add(symbol_table.lookup(method_identifier));
+
+  std::vector<irep_idt> needed_methods;
+  std::set<irep_idt> needed_classes;
+  ci_lazy_methodst recorder(
+    needed_methods,
+    needed_classes,
+    method_symbol_table);
+
+  java_bytecode_convert_method(
+    class_symbol,
+    method,
+    method_symbol_table,
+    get_message_handler(),
+    max_array_length,
+    lazy_methods?
+      safe_pointer<ci_lazy_methodst>::create_non_null(&recorder):
+      safe_pointer<ci_lazy_methodst>::create_null(),
+    character_refine);
+
+  entryt &entry=entries[method_identifier];
+  entry.key=key;
+  entry.symbols.clear();
+  entry.needed_methods=needed_methods;
+  entry.needed_classes.assign(needed_classes.begin(), needed_classes.end());
+
+  forall_symbols(it, method_symbol_table.symbols)
+    entry.symbols.push_back(it->second);
+
+  modified=true;
+
+  apply(method_identifier, entry, symbol_table, lazy_methods);
+}
+
+void java_method_cachet::apply(
+  const irep_idt &method_identifier,
+  const entryt &entry,
+  symbol_tablet &symbol_table,
+  safe_pointer<ci_lazy_methodst> lazy_methods)
+{
+  for(const auto &symbol : entry.symbols)
+  {
+    if(symbol.name==method_identifier)
+    {
+      // replace the stub symbol, as java_bytecode_convert_method does
+      const auto s_it=symbol_table.symbols.find(method_identifier);
+      assert(s_it!=symbol_table.symbols.end());
+      symbol_table.symbols.erase(s_it);
+    }
+
+    // symbols that exist already, e.g., stubs of callees, are kept
+    symbol_table.add(symbol);
+  }
+
+  if(lazy_methods)
+  {
+    for(const auto &class_name : entry.needed_classes)
+      lazy_methods->add_needed_class(class_name);
+
+    for(const auto &method_name : entry.needed_methods)
+      lazy_methods->add_needed_method(method_name);
+  }
+}
+
+bool java_method_cachet::read(const std::string &file_name)
+{
+  if(!std::ifstream(file_name))
+  {
+    status() << "No cached Java methods in `" << file_name << "'" << eom;
+    return false;
+  }
+
+  symbol_tablet symbol_table;
+  goto_functionst goto_functions;
+
+  if(read_goto_binary(
+       file_name, symbol_table, goto_functions, get_message_handler()))
+  {
+    error() << "failed to read cached Java methods from `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  forall_symbols(it, symbol_table.symbols)
+  {
+    const exprt &record=it->second.value;
+
+    entryt &entry=entries[it->second.base_name];
+    entry.key=id2string(record.get("key"));
+
+    for(const auto &symbol : record.find("symbols").get_sub())
+    {
+      entry.symbols.push_back(symbolt());
+      entry.symbols.back().from_irep(symbol);
+    }
+
+    for(const auto &method : record.find("needed_methods").get_sub())
+      entry.needed_methods.push_back(method.id());
+
+    for(const auto &class_name : record.find("needed_classes").get_sub())
+      entry.needed_classes.push_back(class_name.id());
+  }
+
+  status() << "Read " << entries.size() << " cached Java methods" << eom;
+
+  return false;
+}
+
+bool java_method_cachet::write(const std::string &file_name)
+{
+  symbol_tablet symbol_table;
+
+  for(const auto &entry : entries)
+  {
+    exprt record;
+    record.set("key", entry.second.key);
+
+    irept::subt &symbols=record.add("symbols").get_sub();
+    for(const auto &symbol : entry.second.symbols)
+      symbols.push_back(symbol.to_irep());
+
+    irept::subt &needed_methods=record.add("needed_methods").get_sub();
+    for(const auto &method : entry.second.needed_methods)
+      needed_methods.push_back(irept(method));
+
+    irept::subt &needed_classes=record.add("needed_classes").get_sub();
+    for(const auto &class_name : entry.second.needed_classes)
+      needed_classes.push_back(irept(class_name));
+
+    symbolt symbol;
+    symbol.name=entry_prefix+id2string(entry.first);
+    symbol.base_name=entry.first;
+    symbol.mode=ID_java;
+    symbol.value.swap(record);
+    symbol_table.add(symbol);
+  }
+
+  if(write_goto_binary(
+       file_name, symbol_table, goto_functionst(), get_message_handler()))
+  {
+    error() << "failed to write cached Java methods to `"
+            << file_name << "'" << eom;
+    return true;
+  }
+
+  modified=false;
+
+  return false;
+}
@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Converted Java Methods
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Persistent Cache of Converted Java Methods
+
+#ifndef CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
+#define CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <util/message.h>
+#include <util/safe_pointer.h>
+#include <util/symbol_table.h>
+
+#include "character_refine_preprocess.h"
+#include "ci_lazy_methods.h"
+#include "java_bytecode_parse_tree.h"
+
+/// Stores the result of java_bytecode_convert_method across runs: the
+/// method symbol, the symbols the conversion adds to the symbol table, and
+/// the methods and classes it marks as needed. Each method is keyed on a
+/// hash of its bytecode, of its class, and of the options the conversion
+/// depends on. The cache is kept in a goto binary.
+class java_method_cachet:public messaget
+{
+public:
+  java_method_cachet(
+    message_handlert &_message_handler,
+    size_t _max_array_length,
+    bool _string_refinement_enabled);
+
+  /// \return true on error; a missing file is not an error
+  bool read(const std::string &file_name);
+
+  /// \return true on error
+  bool write(const std::string &file_name);
+
+  /// Does the same as java_bytecode_convert_method, but takes the result
+  /// from the cache when the method has not changed.
+  void convert_method(
+    const symbolt &class_symbol,
+    const java_bytecode_parse_treet::methodt &,
+    symbol_tablet &,
+    safe_pointer<ci_lazy_methodst> lazy_methods,
+    const character_refine_preprocesst &);
+
+  bool is_modified() const
+  {
+    return modified;
+  }
+
+  std::size_t number_of_hits() const
+  {
+    return hits;
+  }
+
+  std::size_t number_of_misses() const
+  {
+    return misses;
+  }
+
+protected:
+  const size_t max_array_length;
+  const bool string_refinement_enabled;
+
+  struct entryt
+  {
+    std::string key;
+    std::vector<symbolt> symbols;
+    std::vector<irep_idt> needed_methods;
+    std::vector<irep_idt> needed_classes;
+  };
+
+  // keyed on the method identifier
+  typedef std::map<irep_idt, entryt> entriest;
+  entriest entries;
+
+  std::size_t hits;
+  std::size_t misses;
+  bool modified;
+
+  std::string compute_key(
+    const symbolt &class_symbol,
+    const java_bytecode_parse_treet::methodt &,
+    const symbolt &method_symbol,
+    bool lazy);
+
+  void apply(
+    const irep_idt &method_identifier,
+    const entryt &,
+    symbol_tablet &,
+    safe_pointer<ci_lazy_methodst> lazy_methods);
+};
+
+#endif // CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
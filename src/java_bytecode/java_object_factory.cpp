@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "java_object_factory.h"
 
+#include <set>
 #include <unordered_set>
 #include <sstream>
 
@@ -42,6 +43,11 @@ static symbolt &new_tmp_symbol(
     symbol_table);
 }
 
+// How often the initialization of a cycle of classes, e.g., of a class A
+// with a field of class B that has a field of class A, is unrolled. Fields
+// of the class of the object itself are always null.
+#define MAX_NONDET_RECURSION_DEPTH 2
+
 /// \par parameters: Desired type (C_bool or plain bool)
 /// \return nondet expr of that type
 static exprt get_nondet_bool(const typet &type)
@@ -61,6 +67,16 @@ class java_object_factoryt
   symbol_tablet &symbol_table;
   namespacet ns;
 
+  // The depth of the object being initialized in a cycle of classes; this
+  // is the parameter of the initialization function, or 0 outside of them.
+  const exprt depth;
+
+  // initialization functions whose body is being generated
+  std::set<irep_idt> &functions_in_progress;
+
+  irep_idt init_function_name(const struct_typet &) const;
+  irep_idt gen_init_function(const struct_typet &);
+
   code_assignt get_null_assignment(
     const exprt &expr,
     const pointer_typet &ptr_type);
@@ -69,7 +85,8 @@ class java_object_factoryt
     code_blockt &assignments,
     const exprt &expr,
     const typet &target_type,
-    bool create_dynamic_objects);
+    bool create_dynamic_objects,
+    const exprt &target_depth);
 
   void allocate_nondet_length_array(
     code_blockt &assignments,
@@ -83,13 +100,17 @@ public:
     const source_locationt &loc,
     bool _assume_non_null,
     size_t _max_nondet_array_length,
-    symbol_tablet &_symbol_table):
+    symbol_tablet &_symbol_table,
+    const exprt &_depth,
+    std::set<irep_idt> &_functions_in_progress):
       symbols_created(_symbols_created),
       loc(loc),
       assume_non_null(_assume_non_null),
       max_nondet_array_length(_max_nondet_array_length),
       symbol_table(_symbol_table),
-      ns(_symbol_table)
+      ns(_symbol_table),
+      depth(_depth),
+      functions_in_progress(_functions_in_progress)
   {}
 
   exprt allocate_object(
@@ -112,6 +133,8 @@ public:
     const typet &override_type=empty_typet());
 
 private:
+  bool is_array(const typet &) const;
+
   void gen_nondet_pointer_init(
     code_blockt &assignments,
     const exprt &expr,
@@ -119,6 +142,13 @@ private:
     bool create_dynamic_objects,
     const pointer_typet &pointer_type);
 
+  void gen_nondet_pointer_init(
+    code_blockt &assignments,
+    const exprt &expr,
+    const pointer_typet &pointer_type,
+    bool create_dynamic_objects,
+    const exprt &target_depth);
+
   void gen_nondet_struct_init(
     code_blockt &assignments,
     const exprt &expr,
@@ -202,6 +232,115 @@ exprt java_object_factoryt::allocate_object(
   }
 }
 
+/// \return true if `type` is the struct type of a Java array
+bool java_object_factoryt::is_array(const typet &type) const
+{
+  return
+    type.id()==ID_struct &&
+    has_prefix(id2string(to_struct_type(type).get_tag()), "java::array[");
+}
+
+/// \par parameters: `struct_type`: a Java class
+/// \return the name of the function that initializes the members of an object
+///   of the class
+irep_idt java_object_factoryt::init_function_name(
+  const struct_typet &struct_type) const
+{
+  return
+    "java::"+id2string(struct_type.get_tag())+"::nondet_initialize"+
+    (assume_non_null?"_non_null":"");
+}
+
+/// Generates the function that nondet-initialises the members of an object of
+/// a class, unless it exists already. The function takes a pointer to the
+/// object and the depth of the object in a cycle of classes.
+/// \par parameters: `struct_type`: a Java class
+/// \return the name of the function
+irep_idt java_object_factoryt::gen_init_function(
+  const struct_typet &struct_type)
+{
+  const irep_idt function_name=init_function_name(struct_type);
+
+  if(symbol_table.has_symbol(function_name))
+    return function_name;
+
+  const symbol_typet class_type("java::"+id2string(struct_type.get_tag()));
+
+  code_typet function_type;
+  function_type.return_type()=empty_typet();
+
+  code_typet::parametert this_parameter(pointer_type(class_type));
+  this_parameter.set_base_name("this");
+  this_parameter.set_identifier(id2string(function_name)+"::this");
+  function_type.parameters().push_back(this_parameter);
+
+  code_typet::parametert depth_parameter(java_int_type());
+  depth_parameter.set_base_name("depth");
+  depth_parameter.set_identifier(id2string(function_name)+"::depth");
+  function_type.parameters().push_back(depth_parameter);
+
+  for(const auto &parameter : function_type.parameters())
+  {
+    parameter_symbolt parameter_symbol;
+    parameter_symbol.base_name=parameter.get_base_name();
+    parameter_symbol.mode=ID_java;
+    parameter_symbol.name=parameter.get_identifier();
+    parameter_symbol.type=parameter.type();
+    symbol_table.add(parameter_symbol);
+  }
+
+  // Add the symbol before generating the body, which may refer to it.
+  symbolt function_symbol;
+  function_symbol.name=function_name;
+  function_symbol.base_name="nondet_initialize";
+  function_symbol.pretty_name=function_name;
+  function_symbol.type=function_type;
+  function_symbol.mode=ID_java;
+  function_symbol.location=loc;
+  symbol_table.add(function_symbol);
+
+  const symbol_exprt this_expr(
+    this_parameter.get_identifier(), this_parameter.type());
+  const symbol_exprt depth_expr(
+    depth_parameter.get_identifier(), depth_parameter.type());
+
+  functions_in_progress.insert(function_name);
+
+  std::vector<const symbolt *> function_symbols_created;
+  java_object_factoryt function_factory(
+    function_symbols_created,
+    loc,
+    assume_non_null,
+    max_nondet_array_length,
+    symbol_table,
+    depth_expr,
+    functions_in_progress);
+
+  code_blockt assignments;
+  function_factory.gen_nondet_struct_init(
+    assignments,
+    dereference_exprt(this_expr, class_type),
+    false,
+    "",
+    true,
+    struct_type);
+
+  functions_in_progress.erase(function_name);
+
+  code_blockt body;
+  for(const symbolt * const symbol_ptr : function_symbols_created)
+  {
+    code_declt decl(symbol_ptr->symbol_expr());
+    decl.add_source_location()=loc;
+    body.add(decl);
+  }
+  body.append(assignments);
+
+  symbol_table.symbols.find(function_name)->second.value.swap(body);
+
+  return function_name;
+}
+
 /// Adds an instruction to `init_code` null-initialising `expr`.
 /// \par parameters: `expr`: pointer-typed lvalue expression to initialise
 /// `ptr_type`: pointer type to write
@@ -226,21 +365,46 @@ code_assignt java_object_factoryt::get_null_assignment(
 /// `update_in_place`: NO_UPDATE_IN_PLACE: initialise `expr` from scratch
 ///   MUST_UPDATE_IN_PLACE: reinitialise an existing object MAY_UPDATE_IN_PLACE:
 ///   invalid input
+/// `target_depth`: the depth argument for the initialization function of the
+///   class of the target
 void java_object_factoryt::gen_pointer_target_init(
   code_blockt &assignments,
   const exprt &expr,
   const typet &target_type,
-  bool create_dynamic_objects)
+  bool create_dynamic_objects,
+  const exprt &target_depth)
 {
-  if(target_type.id()==ID_struct &&
-     has_prefix(
-       id2string(to_struct_type(target_type).get_tag()),
-       "java::array["))
+  if(is_array(target_type))
   {
     gen_nondet_array_init(
       assignments,
       expr);
   }
+  else if(target_type.id()==ID_struct)
+  {
+    // The members are initialized by a function shared by all objects of
+    // the class, which allocates the objects they point to on the heap.
+    const struct_typet &struct_type=to_struct_type(target_type);
+    const irep_idt function_name=gen_init_function(struct_type);
+    const symbolt &function_symbol=ns.lookup(function_name);
+    const code_typet::parameterst &parameters=
+      to_code_type(function_symbol.type).parameters();
+
+    exprt target=allocate_object(
+      assignments,
+      expr,
+      target_type,
+      create_dynamic_objects);
+
+    code_function_callt call;
+    call.function()=function_symbol.symbol_expr();
+    call.arguments().push_back(target);
+    if(target.type()!=parameters[0].type())
+      call.arguments().back().make_typecast(parameters[0].type());
+    call.arguments().push_back(target_depth);
+    call.add_source_location()=loc;
+    assignments.move_to_operands(call);
+  }
   else
   {
     exprt target;
@@ -285,6 +449,9 @@ void java_object_factoryt::gen_nondet_pointer_init(
 {
   const typet &subtype=ns.follow(pointer_type.subtype());
 
+  // the class of the target is part of a cycle of classes
+  bool is_recursive=false;
+
   if(subtype.id()==ID_struct)
   {
     const struct_typet &struct_type=to_struct_type(subtype);
@@ -297,14 +464,74 @@ void java_object_factoryt::gen_nondet_pointer_init(
         get_null_assignment(expr, pointer_type));
       return;
     }
+
+    is_recursive=
+      !is_array(struct_type) &&
+      functions_in_progress.count(init_function_name(struct_type))!=0;
   }
 
+  if(is_recursive)
+  {
+    // if(depth>=MAX_NONDET_RECURSION_DEPTH)
+    //   <expr> = <null pointer>
+    // else
+    //   <initialization of the target at depth+1>
+    code_blockt bounded_inst;
+    const exprt next_depth=
+      plus_exprt(depth, from_integer(1, depth.type()));
+    gen_nondet_pointer_init(
+      bounded_inst,
+      expr,
+      pointer_type,
+      create_dynamic_objects,
+      next_depth);
+
+    code_ifthenelset depth_check;
+    depth_check.cond()=
+      binary_relation_exprt(
+        depth,
+        ID_ge,
+        from_integer(MAX_NONDET_RECURSION_DEPTH, depth.type()));
+    depth_check.then_case()=get_null_assignment(expr, pointer_type);
+    depth_check.else_case()=bounded_inst;
+
+    assignments.add(depth_check);
+  }
+  else
+    gen_nondet_pointer_init(
+      assignments,
+      expr,
+      pointer_type,
+      create_dynamic_objects,
+      depth);
+}
+
+/// Initialises `expr`, of type pointer, with null or with a pointer to a new
+/// object, or only with the latter if null is not allowed.
+/// \param assignments - the code block we are building with
+///   initilisation code
+/// \param expr: lvalue expression to initialise
+/// \param create_dynamic_objects: if true, use malloc to allocate objects;
+///   otherwise generate fresh static symbols.
+/// \param pointer_type - The type of the pointer we are initalising
+/// \param target_depth - The depth argument for the initialization function
+///   of the class of the target
+void java_object_factoryt::gen_nondet_pointer_init(
+  code_blockt &assignments,
+  const exprt &expr,
+  const pointer_typet &pointer_type,
+  bool create_dynamic_objects,
+  const exprt &target_depth)
+{
+  const typet &subtype=ns.follow(pointer_type.subtype());
+
   code_blockt non_null_inst;
   gen_pointer_target_init(
     non_null_inst,
     expr,
     subtype,
-    create_dynamic_objects);
+    create_dynamic_objects,
+    target_depth);
 
   if(assume_non_null)
   {
@@ -636,12 +863,15 @@ exprt object_factory(
   std::vector<const symbolt *> symbols_created;
   symbols_created.push_back(main_symbol_ptr);
 
+  std::set<irep_idt> functions_in_progress;
   java_object_factoryt state(
     symbols_created,
     loc,
     !allow_null,
     max_nondet_array_length,
-    symbol_table);
+    symbol_table,
+    from_integer(0, java_int_type()),
+    functions_in_progress);
   code_blockt assignments;
   state.gen_nondet_init(
     assignments,
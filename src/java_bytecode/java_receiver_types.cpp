@@ -0,0 +1,233 @@
+/*******************************************************************\
+
+Module: Receiver Types of Virtual Calls
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Receiver Types of Virtual Calls
+
+#include "java_receiver_types.h"
+
+#include <map>
+#include <vector>
+
+#include <util/std_expr.h>
+#include <util/symbol.h>
+
+class java_receiver_typest
+{
+public:
+  explicit java_receiver_typest(const symbolt &method_symbol);
+
+  void operator()(exprt &body);
+
+protected:
+  // classes the value of a local may have
+  struct valuet
+  {
+    valuet():unknown(false)
+    {
+    }
+
+    bool unknown;
+    std::set<irep_idt> types;
+  };
+
+  std::map<irep_idt, valuet> values;
+  std::vector<std::pair<irep_idt, const exprt *>> assignments;
+
+  void gather(const exprt &code);
+  void set_unknown(const irept &irep);
+  bool merge(valuet &dest, const exprt &rhs) const;
+  void annotate(exprt &code) const;
+};
+
+java_receiver_typest::java_receiver_typest(const symbolt &method_symbol)
+{
+  // the parameters are assigned by the caller
+  for(const auto &parameter : to_code_type(method_symbol.type).parameters())
+    values[parameter.get_identifier()].unknown=true;
+}
+
+/// Marks all the symbols in \p irep as having unknown values
+void java_receiver_typest::set_unknown(const irept &irep)
+{
+  if(irep.id()==ID_symbol)
+    values[irep.get(ID_identifier)].unknown=true;
+
+  forall_irep(it, irep.get_sub())
+    set_unknown(*it);
+}
+
+/// Collects the assignments to local variables; symbols that are written
+/// in any other way get an unknown value.
+void java_receiver_typest::gather(const exprt &code)
+{
+  if(code.id()!=ID_code)
+    return;
+
+  const irep_idt &statement=to_code(code).get_statement();
+
+  if(statement==ID_assign)
+  {
+    const code_assignt &assign=to_code_assign(to_code(code));
+
+    if(assign.lhs().id()==ID_symbol)
+      assignments.push_back(
+        std::make_pair(
+          to_symbol_expr(assign.lhs()).get_identifier(),
+          &assign.rhs()));
+  }
+  else if(statement==ID_function_call)
+  {
+    const code_function_callt &call=to_code_function_call(to_code(code));
+
+    if(call.lhs().id()==ID_symbol)
+      values[to_symbol_expr(call.lhs()).get_identifier()].unknown=true;
+  }
+  else if(statement==ID_decl || statement==ID_dead)
+  {
+  }
+  else
+  {
+    const bool reads_only=
+      statement==ID_ifthenelse ||
+      statement==ID_return ||
+      statement==ID_assert ||
+      statement==ID_assume;
+
+    // This includes, e.g., the exception variable of a catch.
+    forall_operands(it, code)
+    {
+      if(it->id()==ID_code)
+        gather(*it);
+      else if(!reads_only)
+        set_unknown(*it);
+    }
+  }
+}
+
+/// Adds the classes \p rhs may have to \p dest
+/// \return true if \p dest changed
+bool java_receiver_typest::merge(valuet &dest, const exprt &rhs) const
+{
+  if(dest.unknown)
+    return false;
+
+  const exprt *e=&rhs;
+  while(e->id()==ID_typecast)
+    e=&e->op0();
+
+  if(e->id()==ID_side_effect &&
+     e->get(ID_statement)==ID_java_new &&
+     e->type().id()==ID_pointer &&
+     e->type().subtype().id()==ID_symbol)
+  {
+    return dest.types.insert(
+      to_symbol_type(e->type().subtype()).get_identifier()).second;
+  }
+  else if(e->id()==ID_constant && e->get(ID_value)==ID_NULL)
+  {
+    return false;
+  }
+  else if(e->id()==ID_symbol)
+  {
+    const auto v_it=values.find(to_symbol_expr(*e).get_identifier());
+
+    // not assigned in this method
+    if(v_it==values.end() || v_it->second.unknown)
+    {
+      dest.unknown=true;
+      return true;
+    }
+
+    const std::size_t old_size=dest.types.size();
+    dest.types.insert(v_it->second.types.begin(), v_it->second.types.end());
+    return dest.types.size()!=old_size;
+  }
+  else
+  {
+    dest.unknown=true;
+    return true;
+  }
+}
+
+void java_receiver_typest::annotate(exprt &code) const
+{
+  if(code.id()!=ID_code)
+    return;
+
+  if(to_code(code).get_statement()==ID_function_call)
+  {
+    code_function_callt &call=to_code_function_call(to_code(code));
+
+    if(call.function().id()!=ID_virtual_function ||
+       call.arguments().empty())
+      return;
+
+    const exprt *receiver=&call.arguments()[0];
+    while(receiver->id()==ID_typecast)
+      receiver=&receiver->op0();
+
+    if(receiver->id()!=ID_symbol)
+      return;
+
+    const auto v_it=values.find(to_symbol_expr(*receiver).get_identifier());
+    if(v_it==values.end() ||
+       v_it->second.unknown ||
+       v_it->second.types.empty())
+      return;
+
+    irept::subt &types=call.function().add(ID_C_receiver_types).get_sub();
+    types.clear();
+    for(const auto &type : v_it->second.types)
+      types.push_back(irept(type));
+  }
+  else
+    Forall_operands(it, code)
+      annotate(*it);
+}
+
+void java_receiver_typest::operator()(exprt &body)
+{
+  gather(body);
+
+  for(const auto &assignment : assignments)
+    values[assignment.first];
+
+  // iterate to a fixed point; the sets only grow
+  bool changed=true;
+  while(changed)
+  {
+    changed=false;
+
+    for(const auto &assignment : assignments)
+      if(merge(values[assignment.first], *assignment.second))
+        changed=true;
+  }
+
+  annotate(body);
+}
+
+void annotate_receiver_types(symbolt &method_symbol)
+{
+  if(method_symbol.value.id()!=ID_code)
+    return;
+
+  java_receiver_typest java_receiver_types(method_symbol);
+  java_receiver_types(method_symbol.value);
+}
+
+std::set<irep_idt> get_receiver_types(const code_function_callt &call)
+{
+  std::set<irep_idt> result;
+
+  for(const auto &type :
+        call.function().find(ID_C_receiver_types).get_sub())
+    result.insert(type.id());
+
+  return result;
+}
@@ -0,0 +1,32 @@
+/*******************************************************************\
+
+Module: Receiver Types of Virtual Calls
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Receiver Types of Virtual Calls
+
+#ifndef CPROVER_JAVA_BYTECODE_JAVA_RECEIVER_TYPES_H
+#define CPROVER_JAVA_BYTECODE_JAVA_RECEIVER_TYPES_H
+
+#include <set>
+
+#include <util/std_code.h>
+
+class symbolt;
+
+/// Propagates the types of the objects allocated in the body of
+/// \p method_symbol through its local variables. Each virtual call whose
+/// `this` argument can only refer to such objects is annotated with the
+/// set of classes (ID_C_receiver_types) its receiver may have; other calls
+/// are left alone.
+void annotate_receiver_types(symbolt &method_symbol);
+
+/// \return the classes the receiver of the virtual call \p call may have,
+///   or the empty set if they are not known
+std::set<irep_idt> get_receiver_types(const code_function_callt &call);
+
+#endif // CPROVER_JAVA_BYTECODE_JAVA_RECEIVER_TYPES_H
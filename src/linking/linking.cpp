@@ -1239,11 +1239,14 @@ void linkingt::rename_symbols(const id_sett &needs_to_be_renamed)
 void linkingt::copy_symbols()
 {
   // First apply the renaming
-  Forall_symbols(s_it, src_symbol_table.symbols)
+  if(!rename_symbol.empty())
   {
-    // apply the renaming
-    rename_symbol(s_it->second.type);
-    rename_symbol(s_it->second.value);
+    Forall_symbols(s_it, src_symbol_table.symbols)
+    {
+      // apply the renaming
+      rename_symbol(s_it->second.type);
+      rename_symbol(s_it->second.value);
+    }
   }
 
   // Move over all the non-colliding ones
@@ -1287,7 +1290,12 @@ void linkingt::copy_symbols()
       duplicate_non_type_symbol(old_symbol, new_symbol);
   }
 
-  // Apply type updates to initializers
+  // Apply type updates to initializers. This walks the entire main
+  // symbol table, which grows with every object that is linked, and
+  // hence is only done when there is something to update.
+  if(object_type_updates.empty())
+    return;
+
   Forall_symbols(s_it, main_symbol_table.symbols)
   {
     if(!s_it->second.is_type &&
@@ -1324,10 +1332,13 @@ void linkingt::typecheck()
   }
 
   // renaming types may trigger further renaming
-  do_type_dependencies(needs_to_be_renamed);
+  if(!needs_to_be_renamed.empty())
+  {
+    do_type_dependencies(needs_to_be_renamed);
 
-  // PHASE 2: actually rename them
-  rename_symbols(needs_to_be_renamed);
+    // PHASE 2: actually rename them
+    rename_symbols(needs_to_be_renamed);
+  }
 
   // PHASE 3: copy new symbols to main table
   copy_symbols();
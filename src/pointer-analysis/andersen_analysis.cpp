@@ -0,0 +1,313 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Inclusion-Based Points-To Analysis
+
+#include "andersen_analysis.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+bool andersen_analysist::insert(node_sett &dest, nodet node)
+{
+  node_sett::iterator it=std::lower_bound(dest.begin(), dest.end(), node);
+
+  if(it!=dest.end() && *it==node)
+    return false;
+
+  dest.insert(it, node);
+  return true;
+}
+
+bool andersen_analysist::insert(node_sett &dest, const node_sett &src)
+{
+  if(std::includes(dest.begin(), dest.end(), src.begin(), src.end()))
+    return false;
+
+  node_sett result;
+  result.reserve(dest.size()+src.size());
+  std::set_union(
+    dest.begin(), dest.end(),
+    src.begin(), src.end(),
+    std::back_inserter(result));
+  dest.swap(result);
+
+  return true;
+}
+
+void andersen_analysist::solve()
+{
+  unknown_targets=temporary_node();
+
+  const std::size_t size=nodes.size();
+
+  representatives.resize(size);
+  points_to.resize(size);
+  successors.resize(size);
+  loads.resize(size);
+  stores.resize(size);
+  calls.resize(size);
+
+  for(const auto &constraint : constraints)
+  {
+    switch(constraint.kind)
+    {
+    case constraint_kindt::ADDRESS_OF:
+      insert(points_to[constraint.dest], constraint.src);
+      insert(successors[unknown_targets], constraint.src);
+      break;
+    case constraint_kindt::COPY:
+      insert(successors[constraint.src], constraint.dest);
+      break;
+    case constraint_kindt::LOAD:
+      loads[constraint.src].push_back(constraint.dest);
+      break;
+    case constraint_kindt::STORE:
+      stores[constraint.dest].push_back(constraint.src);
+      break;
+    }
+  }
+
+  for(std::size_t i=0; i<indirect_calls.size(); i++)
+    calls[indirect_calls[i].function].push_back(i);
+
+  nodest order;
+
+  do
+  {
+    order.clear();
+    collapse_cycles(order);
+    propagate(order);
+  }
+  while(add_complex_edges());
+}
+
+void andersen_analysist::get_points_to(nodet node, nodest &dest) const
+{
+  // nodes created after solving do not point anywhere
+  if(node>=points_to.size())
+    return;
+
+  const node_sett &objects=points_to[representative(node)];
+  dest.insert(dest.end(), objects.begin(), objects.end());
+}
+
+bool andersen_analysist::add_edge(nodet from, nodet to)
+{
+  from=representative(from);
+  to=representative(to);
+
+  if(from==to)
+    return false;
+
+  return insert(successors[from], to);
+}
+
+/// Collapses the strongly connected components of the copy graph using
+/// Tarjan's algorithm
+/// \param order: receives the representatives in reverse topological
+///   order
+void andersen_analysist::collapse_cycles(nodest &order)
+{
+  const std::size_t size=points_to.size();
+  const std::size_t unvisited=std::numeric_limits<std::size_t>::max();
+
+  std::vector<std::size_t> index(size, unvisited);
+  std::vector<std::size_t> lowlink(size, 0);
+  std::vector<bool> on_stack(size, false);
+  nodest stack;
+  std::size_t next_index=0;
+
+  // the depth-first search is iterative to cope with long chains,
+  // each frame holds a node and the position in its successors
+  std::vector<std::pair<nodet, std::size_t>> frames;
+
+  for(nodet root=0; root<size; root++)
+  {
+    if(representative(root)!=root || index[root]!=unvisited)
+      continue;
+
+    index[root]=lowlink[root]=next_index++;
+    stack.push_back(root);
+    on_stack[root]=true;
+    frames.push_back(std::make_pair(root, 0));
+
+    while(!frames.empty())
+    {
+      const nodet v=frames.back().first;
+      const std::size_t position=frames.back().second;
+
+      if(position<successors[v].size())
+      {
+        frames.back().second++;
+
+        const nodet w=representative(successors[v][position]);
+
+        if(w==v)
+          continue;
+
+        if(index[w]==unvisited)
+        {
+          index[w]=lowlink[w]=next_index++;
+          stack.push_back(w);
+          on_stack[w]=true;
+          frames.push_back(std::make_pair(w, 0));
+        }
+        else if(on_stack[w])
+          lowlink[v]=std::min(lowlink[v], index[w]);
+
+        continue;
+      }
+
+      frames.pop_back();
+
+      if(!frames.empty())
+      {
+        const nodet u=frames.back().first;
+        lowlink[u]=std::min(lowlink[u], lowlink[v]);
+      }
+
+      if(lowlink[v]==index[v])
+      {
+        nodest cycle;
+        nodet w;
+
+        do
+        {
+          w=stack.back();
+          stack.pop_back();
+          on_stack[w]=false;
+          cycle.push_back(w);
+        }
+        while(w!=v);
+
+        order.push_back(collapse(cycle));
+      }
+    }
+  }
+}
+
+/// Merges the nodes of a cycle into a single representative
+/// \return the representative
+andersen_analysist::nodet andersen_analysist::collapse(const nodest &cycle)
+{
+  if(cycle.size()==1)
+    return cycle.front();
+
+  for(const auto &node : cycle)
+    representatives.make_union(cycle.front(), node);
+
+  const nodet root=representative(cycle.front());
+
+  for(const auto &node : cycle)
+  {
+    if(node==root)
+      continue;
+
+    insert(points_to[root], points_to[node]);
+    insert(successors[root], successors[node]);
+    loads[root].insert(loads[root].end(), loads[node].begin(),
+                       loads[node].end());
+    stores[root].insert(stores[root].end(), stores[node].begin(),
+                        stores[node].end());
+    calls[root].insert(calls[root].end(), calls[node].begin(),
+                       calls[node].end());
+
+    node_sett().swap(points_to[node]);
+    node_sett().swap(successors[node]);
+    nodest().swap(loads[node]);
+    nodest().swap(stores[node]);
+    std::vector<std::size_t>().swap(calls[node]);
+  }
+
+  return root;
+}
+
+/// The copy graph is acyclic, hence a single pass in topological order
+/// propagates all points-to sets along the copy edges.
+void andersen_analysist::propagate(const nodest &order)
+{
+  for(nodest::const_reverse_iterator it=order.rbegin();
+      it!=order.rend();
+      it++)
+  {
+    const nodet node=*it;
+
+    if(points_to[node].empty())
+      continue;
+
+    for(const auto &successor : successors[node])
+    {
+      const nodet target=representative(successor);
+
+      if(target!=node)
+        insert(points_to[target], points_to[node]);
+    }
+  }
+}
+
+/// Adds the copy edges implied by loads, stores and indirect calls
+/// through the current points-to sets
+/// \return true if a new edge was added
+bool andersen_analysist::add_complex_edges()
+{
+  bool new_edge=false;
+
+  for(nodet node=0; node<points_to.size(); node++)
+  {
+    if(representative(node)!=node)
+      continue;
+
+    const node_sett &objects=points_to[node];
+
+    for(const auto &object : objects)
+    {
+      // dest = *node
+      for(const auto &dest : loads[node])
+        if(add_edge(object, dest))
+          new_edge=true;
+
+      // *node = src
+      for(const auto &src : stores[node])
+      {
+        if(add_edge(src, object))
+          new_edge=true;
+
+        if(object==unknown_node && add_edge(src, unknown_targets))
+          new_edge=true;
+      }
+
+      for(const auto &call : calls[node])
+      {
+        if(!resolved_calls.insert(std::make_pair(call, object)).second)
+          continue;
+
+        function_mapt::const_iterator f_it=functions.find(object);
+
+        if(f_it==functions.end())
+          continue;
+
+        const indirect_callt &indirect_call=indirect_calls[call];
+        const nodest &parameters=f_it->second.parameters;
+
+        for(std::size_t i=0;
+            i<parameters.size() && i<indirect_call.arguments.size();
+            i++)
+          if(add_edge(indirect_call.arguments[i], parameters[i]))
+            new_edge=true;
+
+        if(add_edge(f_it->second.return_value, indirect_call.result))
+          new_edge=true;
+      }
+    }
+  }
+
+  return new_edge;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Inclusion-Based Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_ANDERSEN_ANALYSIS_H
+#define CPROVER_POINTER_ANALYSIS_ANDERSEN_ANALYSIS_H
+
+#include <set>
+
+#include <util/union_find.h>
+
+#include "points_to_pre_analysis.h"
+
+/// Andersen-style analysis. The constraints are solved by wave
+/// propagation: cycles in the copy graph are collapsed, points-to sets are
+/// propagated once in topological order, and then the edges implied by
+/// loads, stores and indirect calls are added. This is repeated until no
+/// new edges arise. Points-to sets are sorted vectors of node numbers.
+/// A store through a pointer to the unknown object may write to any
+/// object; since fields and casts are not distinguished, the types of the
+/// objects are not used to narrow this down.
+class andersen_analysist:public points_to_pre_analysist
+{
+public:
+  explicit andersen_analysist(const namespacet &_ns):
+    points_to_pre_analysist(_ns)
+  {
+  }
+
+protected:
+  typedef nodest node_sett;
+
+  // nodes in a cycle share their representative
+  unsigned_union_find representatives;
+
+  std::vector<node_sett> points_to;
+  std::vector<node_sett> successors;
+  std::vector<nodest> loads;
+  std::vector<nodest> stores;
+  std::vector<std::vector<std::size_t>> calls;
+
+  // copied to every object, receives the stores through unknown pointers
+  nodet unknown_targets;
+
+  // pairs of indirect call and function already bound
+  std::set<std::pair<std::size_t, nodet>> resolved_calls;
+
+  virtual void solve();
+  virtual void get_points_to(nodet node, nodest &dest) const;
+
+  nodet representative(nodet node) const
+  {
+    return representatives.find(node);
+  }
+
+  bool add_edge(nodet from, nodet to);
+  void collapse_cycles(nodest &order);
+  nodet collapse(const nodest &cycle);
+  void propagate(const nodest &order);
+  bool add_complex_edges();
+
+  static bool insert(node_sett &dest, nodet node);
+  static bool insert(node_sett &dest, const node_sett &src);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_ANDERSEN_ANALYSIS_H
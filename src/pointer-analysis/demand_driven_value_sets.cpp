@@ -0,0 +1,591 @@
+/*******************************************************************\
+
+Module: Demand-Driven Value Set Queries
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Value Set Queries
+
+#include "demand_driven_value_sets.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include <util/arith_tools.h>
+#include <util/invariant.h>
+#include <util/std_code.h>
+
+const unsigned demand_driven_value_setst::no_location=
+  std::numeric_limits<unsigned>::max();
+
+const unsigned demand_driven_value_setst::max_depth=1000;
+
+/// Takes a snapshot of the given functions. The location numbers must be
+/// unique and the incoming edges up to date, i.e., goto_functions.update()
+/// must have been called.
+demand_driven_value_setst::demand_driven_value_setst(
+  const namespacet &_ns,
+  const goto_functionst &goto_functions):
+  ns(_ns),
+  dirty(goto_functions),
+  depth(0),
+  lowest_dependency(no_location),
+  queries(0),
+  cache_hits(0)
+{
+  build(goto_functions);
+}
+
+void demand_driven_value_setst::build(const goto_functionst &goto_functions)
+{
+  forall_goto_functions(f_it, goto_functions)
+  {
+    const code_typet::parameterst &parameter_types=
+      f_it->second.type.parameters();
+
+    for(std::size_t i=0; i<parameter_types.size(); i++)
+    {
+      const irep_idt &identifier=parameter_types[i].get_identifier();
+      if(!identifier.empty())
+        parameters[identifier]=parameter_indext(f_it->first, i);
+    }
+
+    if(f_it->second.body_available())
+      build(f_it->first, f_it->second.body);
+  }
+}
+
+static const exprt &assigned_object(const exprt &lhs)
+{
+  if(lhs.id()==ID_member ||
+     lhs.id()==ID_index ||
+     lhs.id()==ID_typecast ||
+     lhs.id()==ID_byte_extract_little_endian ||
+     lhs.id()==ID_byte_extract_big_endian)
+    return assigned_object(lhs.op0());
+
+  return lhs;
+}
+
+void demand_driven_value_setst::build(
+  const irep_idt &function,
+  const goto_programt &goto_program)
+{
+  // functions with a body get an entry even if they never return a value
+  locationst &function_returns=returns[function];
+
+  forall_goto_program_instructions(it, goto_program)
+  {
+    const unsigned location=it->location_number;
+
+    if(location>=nodes.size())
+      nodes.resize(location+1);
+
+    nodet &node=nodes[location];
+    INVARIANT(
+      node.instruction==nullptr,
+      "location numbers must be unique");
+
+    node.instruction=&*it;
+    node.function=function;
+    node.type=it->type;
+    node.is_entry=(it==goto_program.instructions.begin());
+
+    for(const auto &predecessor : it->incoming_edges)
+      node.predecessors.push_back(predecessor->location_number);
+
+    if(it->is_assign())
+    {
+      node.code=it->code;
+
+      const exprt &lhs=assigned_object(to_code_assign(it->code).lhs());
+      if(lhs.id()==ID_symbol &&
+         is_global(to_symbol_expr(lhs).get_identifier()))
+        global_assignments[to_symbol_expr(lhs).get_identifier()]
+          .push_back(location);
+    }
+    else if(it->is_function_call())
+    {
+      node.code=it->code;
+
+      const code_function_callt &call=to_code_function_call(it->code);
+
+      if(call.function().id()==ID_symbol)
+        direct_calls[to_symbol_expr(call.function()).get_identifier()]
+          .push_back(location);
+      else
+        indirect_calls.push_back(location);
+
+      const exprt &lhs=assigned_object(call.lhs());
+      if(lhs.id()==ID_symbol &&
+         is_global(to_symbol_expr(lhs).get_identifier()))
+        global_assignments[to_symbol_expr(lhs).get_identifier()]
+          .push_back(location);
+    }
+    else if(it->is_decl() || it->is_return())
+    {
+      node.code=it->code;
+
+      if(it->is_return())
+        function_returns.push_back(location);
+    }
+  }
+}
+
+bool demand_driven_value_setst::is_tracked(const irep_idt &identifier) const
+{
+  const symbolt *symbol;
+  if(ns.lookup(identifier, symbol))
+    return false;
+
+  return !symbol->is_type &&
+         ns.follow(symbol->type).id()==ID_pointer &&
+         !dirty(identifier);
+}
+
+bool demand_driven_value_setst::is_global(const irep_idt &identifier) const
+{
+  const symbolt *symbol;
+  if(ns.lookup(identifier, symbol))
+    return false;
+
+  return symbol->is_static_lifetime;
+}
+
+void demand_driven_value_setst::get_values(
+  goto_programt::const_targett l,
+  const exprt &expr,
+  value_setst::valuest &dest)
+{
+  const unsigned location=l->location_number;
+
+  // locations that were added after the snapshot was taken
+  if(location>=nodes.size() ||
+     nodes[location].instruction!=&*l)
+  {
+    dest.push_back(exprt(ID_unknown, expr.type()));
+    return;
+  }
+
+  const object_mapt object_map=evaluate(location, expr);
+
+  // no value at all is no information, e.g., about a function pointer
+  // that is only ever assigned in ways that are not modelled
+  if(object_map.read().empty())
+  {
+    dest.push_back(exprt(ID_unknown, expr.type()));
+    return;
+  }
+
+  for(value_sett::object_map_dt::const_iterator
+      it=object_map.read().begin();
+      it!=object_map.read().end();
+      it++)
+    dest.push_back(value_set.to_expr(it));
+}
+
+/// Memoized query; handles queries that (indirectly) depend on
+/// themselves. A result that depends on a query still in progress further
+/// up the stack is partial and is not cached; the outermost query of such
+/// a cycle is iterated until it is stable.
+demand_driven_value_setst::object_mapt demand_driven_value_setst::lookup(
+  const keyt &key)
+{
+  queries++;
+
+  cachet::iterator c_it=cache.find(key);
+  if(c_it!=cache.end())
+  {
+    cache_hits++;
+
+    if(!c_it->second.complete)
+      lowest_dependency=std::min(lowest_dependency, c_it->second.depth);
+
+    return c_it->second.object_map;
+  }
+
+  if(depth>=max_depth)
+  {
+    object_mapt result;
+    insert_unknown(result, typet());
+    return result;
+  }
+
+  cache_entryt &entry=cache[key];
+  entry.complete=false;
+  entry.depth=depth++;
+
+  const unsigned saved_lowest_dependency=lowest_dependency;
+  bool changed;
+
+  do
+  {
+    lowest_dependency=no_location;
+    const object_mapt object_map=compute(key);
+    changed=value_set.make_union(entry.object_map, object_map);
+  }
+  while(changed && lowest_dependency==entry.depth);
+
+  depth--;
+  const object_mapt result=entry.object_map;
+
+  if(lowest_dependency<entry.depth)
+  {
+    cache.erase(key);
+    lowest_dependency=std::min(saved_lowest_dependency, lowest_dependency);
+  }
+  else
+  {
+    entry.complete=true;
+    lowest_dependency=saved_lowest_dependency;
+  }
+
+  return result;
+}
+
+demand_driven_value_setst::object_mapt demand_driven_value_setst::compute(
+  const keyt &key)
+{
+  if(key.first!=no_location)
+    return local_values(key.first, key.second);
+  else if(parameters.find(key.second)!=parameters.end())
+    return parameter_summary(key.second);
+  else if(returns.find(key.second)!=returns.end())
+    return return_summary(key.second);
+  else
+    return global_summary(key.second);
+}
+
+/// Collects the symbols whose value is read when evaluating the given
+/// expression; objects whose address is taken are not read.
+void demand_driven_value_setst::collect_symbols(
+  const exprt &expr,
+  find_symbols_sett &dest) const
+{
+  if(expr.id()==ID_symbol)
+    dest.insert(to_symbol_expr(expr).get_identifier());
+  else if(expr.id()!=ID_address_of)
+  {
+    forall_operands(it, expr)
+      collect_symbols(*it, dest);
+  }
+}
+
+/// Evaluates an expression in the state before the given location, using
+/// value_sett on a state that holds just the symbols the expression reads.
+demand_driven_value_setst::object_mapt demand_driven_value_setst::evaluate(
+  unsigned location,
+  const exprt &expr)
+{
+  find_symbols_sett symbols;
+  collect_symbols(expr, symbols);
+
+  value_sett state;
+
+  for(const auto &identifier : symbols)
+  {
+    if(!is_tracked(identifier))
+      continue;
+
+    value_sett::entryt &entry=state.values[identifier];
+    entry.identifier=identifier;
+    entry.object_map=values_before(location, identifier);
+  }
+
+  value_setst::valuest values;
+  state.get_value_set(expr, values, ns);
+
+  object_mapt result;
+  insert_values(result, values);
+  return result;
+}
+
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::values_before(
+  unsigned location,
+  const irep_idt &identifier)
+{
+  if(is_global(identifier))
+    return lookup(keyt(no_location, identifier));
+
+  if(location==no_location)
+  {
+    object_mapt result;
+    insert_unknown(result, ns.lookup(identifier).type);
+    return result;
+  }
+
+  return lookup(keyt(location, identifier));
+}
+
+/// Walks backwards from the given location to the instructions that
+/// assign the given local variable.
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::local_values(
+  unsigned location,
+  const irep_idt &identifier)
+{
+  object_mapt result;
+  bool entry_reached=nodes[location].is_entry;
+
+  std::vector<unsigned> worklist(nodes[location].predecessors);
+
+  // only what the walk reaches, which is usually a small part of the
+  // program; the walk may be interrupted by nested queries
+  std::unordered_set<unsigned> visited;
+
+  while(!worklist.empty())
+  {
+    const unsigned n=worklist.back();
+    worklist.pop_back();
+
+    if(!visited.insert(n).second)
+      continue;
+
+    const nodet &node=nodes[n];
+
+    if(assigns(node, identifier))
+    {
+      value_set.make_union(result, values_assigned(n, identifier));
+      continue;
+    }
+
+    if(node.is_entry)
+      entry_reached=true;
+
+    worklist.insert(
+      worklist.end(), node.predecessors.begin(), node.predecessors.end());
+  }
+
+  if(entry_reached)
+  {
+    if(parameters.find(identifier)!=parameters.end())
+      value_set.make_union(result, lookup(keyt(no_location, identifier)));
+    else
+      insert_unknown(result, ns.lookup(identifier).type);
+  }
+
+  return result;
+}
+
+bool demand_driven_value_setst::assigns(
+  const nodet &node,
+  const irep_idt &identifier) const
+{
+  const exprt *lhs;
+
+  if(node.type==ASSIGN)
+    lhs=&to_code_assign(node.code).lhs();
+  else if(node.type==FUNCTION_CALL)
+    lhs=&to_code_function_call(node.code).lhs();
+  else if(node.type==DECL)
+    lhs=&to_code_decl(node.code).symbol();
+  else
+    return false;
+
+  const exprt &object=assigned_object(*lhs);
+
+  return object.id()==ID_symbol &&
+         to_symbol_expr(object).get_identifier()==identifier;
+}
+
+/// \return The values the given variable has after the assignment at the
+///   given location.
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::values_assigned(
+  unsigned location,
+  const irep_idt &identifier)
+{
+  const nodet &node=nodes[location];
+  object_mapt result;
+
+  if(node.type==ASSIGN)
+  {
+    const code_assignt &assign=to_code_assign(node.code);
+
+    if(assign.lhs().id()==ID_symbol)
+      return evaluate(location, assign.rhs());
+  }
+  else if(node.type==FUNCTION_CALL)
+  {
+    const code_function_callt &call=to_code_function_call(node.code);
+
+    if(call.lhs().id()==ID_symbol)
+    {
+      if(call.function().id()==ID_symbol)
+        return lookup(
+          keyt(no_location, to_symbol_expr(call.function()).get_identifier()));
+
+      const object_mapt targets=evaluate(location, call.function().op0());
+
+      if(targets.read().empty())
+        insert_unknown(result, call.lhs().type());
+
+      for(const auto &target : targets.read())
+      {
+        const exprt &object=value_sett::object_numbering[target.first];
+
+        if(object.id()==ID_symbol &&
+           object.type().id()==ID_code)
+          value_set.make_union(
+            result,
+            lookup(keyt(no_location, to_symbol_expr(object).get_identifier())));
+        else if(object.id()==ID_unknown)
+          insert_unknown(result, call.lhs().type());
+      }
+
+      return result;
+    }
+  }
+
+  // uninitialised after a declaration, and anything we don't model
+  insert_unknown(result, ns.lookup(identifier).type);
+  return result;
+}
+
+/// The values of a variable with static lifetime are the union over all
+/// assignments to it, regardless of the location.
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::global_summary(const irep_idt &identifier)
+{
+  object_mapt result;
+
+  location_mapt::const_iterator a_it=global_assignments.find(identifier);
+
+  if(a_it==global_assignments.end())
+  {
+    // there is no initialisation code, use the initial value
+    const symbolt &symbol=ns.lookup(identifier);
+
+    if(symbol.value.is_nil())
+      insert_unknown(result, symbol.type);
+    else
+      result=evaluate(no_location, symbol.value);
+
+    return result;
+  }
+
+  for(const auto &location : a_it->second)
+    value_set.make_union(result, values_assigned(location, identifier));
+
+  return result;
+}
+
+/// The values of a parameter on entry are the values of the corresponding
+/// argument at all call sites that may call the function.
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::parameter_summary(const irep_idt &identifier)
+{
+  const parameter_indext &parameter=parameters[identifier];
+  const irep_idt &function=parameter.first;
+  const std::size_t index=parameter.second;
+
+  locationst callers;
+
+  location_mapt::const_iterator c_it=direct_calls.find(function);
+  if(c_it!=direct_calls.end())
+    callers=c_it->second;
+
+  for(const auto &location : indirect_calls)
+    if(may_call(location, function))
+      callers.push_back(location);
+
+  object_mapt result;
+
+  // nobody calls it: it's an entry point
+  if(callers.empty())
+    insert_unknown(result, ns.lookup(identifier).type);
+
+  for(const auto &location : callers)
+  {
+    const code_function_callt::argumentst &arguments=
+      to_code_function_call(nodes[location].code).arguments();
+
+    if(index<arguments.size())
+      value_set.make_union(result, evaluate(location, arguments[index]));
+    else
+      insert_unknown(result, ns.lookup(identifier).type);
+  }
+
+  return result;
+}
+
+/// The values returned by a function are the values of the operands of
+/// its return statements.
+demand_driven_value_setst::object_mapt
+demand_driven_value_setst::return_summary(const irep_idt &function)
+{
+  object_mapt result;
+
+  for(const auto &location : returns[function])
+  {
+    const code_returnt &code_return=to_code_return(nodes[location].code);
+
+    if(code_return.has_return_value())
+      value_set.make_union(
+        result,
+        evaluate(location, code_return.return_value()));
+  }
+
+  return result;
+}
+
+bool demand_driven_value_setst::may_call(
+  unsigned location,
+  const irep_idt &function)
+{
+  const code_function_callt &call=
+    to_code_function_call(nodes[location].code);
+
+  const object_mapt targets=evaluate(location, call.function().op0());
+
+  // the targets are not known
+  if(targets.read().empty())
+    return true;
+
+  for(const auto &target : targets.read())
+  {
+    const exprt &object=value_sett::object_numbering[target.first];
+
+    if(object.id()==ID_unknown ||
+       (object.id()==ID_symbol &&
+        to_symbol_expr(object).get_identifier()==function))
+      return true;
+  }
+
+  return false;
+}
+
+void demand_driven_value_setst::insert_values(
+  object_mapt &dest,
+  const value_setst::valuest &src)
+{
+  for(const auto &value : src)
+  {
+    if(value.id()==ID_object_descriptor)
+    {
+      const object_descriptor_exprt &object_descriptor=
+        to_object_descriptor_expr(value);
+      mp_integer offset;
+
+      if(object_descriptor.offset().is_constant() &&
+         !to_integer(object_descriptor.offset(), offset))
+        value_set.insert(dest, object_descriptor.object(), offset);
+      else
+        value_set.insert(dest, object_descriptor.object());
+    }
+    else
+      value_set.insert(dest, value);
+  }
+}
+
+void demand_driven_value_setst::insert_unknown(
+  object_mapt &dest,
+  const typet &type)
+{
+  value_set.insert(dest, exprt(ID_unknown, type));
+}
@@ -0,0 +1,141 @@
+/*******************************************************************\
+
+Module: Demand-Driven Value Set Queries
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Value Set Queries
+
+#ifndef CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
+#define CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
+
+#include <map>
+#include <vector>
+
+#include <util/find_symbols.h>
+
+#include <analyses/dirty.h>
+
+#include "value_set.h"
+#include "value_sets.h"
+
+/// Answers points-to queries at individual program locations without
+/// computing a whole-program fixpoint. The values of a pointer variable
+/// are found by walking backwards from the query location to the
+/// assignments that reach it; parameters, return values and global
+/// variables are answered by function summaries. All results are
+/// memoized. Only pointer variables whose address is never taken are
+/// tracked; everything else is reported as unknown.
+class demand_driven_value_setst:public value_setst
+{
+public:
+  demand_driven_value_setst(
+    const namespacet &_ns,
+    const goto_functionst &goto_functions);
+
+  virtual void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    value_setst::valuest &dest);
+
+  std::size_t number_of_queries() const
+  {
+    return queries;
+  }
+
+  std::size_t number_of_cache_hits() const
+  {
+    return cache_hits;
+  }
+
+protected:
+  const namespacet &ns;
+  const dirtyt dirty;
+  value_sett value_set;
+  typedef value_sett::object_mapt object_mapt;
+
+  // A snapshot of the instructions relevant to the queries, indexed by
+  // location number. Later changes to the goto program do not affect it.
+  struct nodet
+  {
+    const goto_programt::instructiont *instruction;
+    irep_idt function;
+    goto_program_instruction_typet type;
+    bool is_entry;
+    codet code;
+    std::vector<unsigned> predecessors;
+
+    nodet():
+      instruction(nullptr),
+      type(NO_INSTRUCTION_TYPE),
+      is_entry(false)
+    {
+    }
+  };
+
+  typedef std::vector<nodet> nodest;
+  nodest nodes;
+
+  typedef std::vector<unsigned> locationst;
+  typedef std::map<irep_idt, locationst> location_mapt;
+  location_mapt direct_calls;
+  location_mapt returns;
+  location_mapt global_assignments;
+  locationst indirect_calls;
+
+  // function and argument index of each parameter
+  typedef std::pair<irep_idt, std::size_t> parameter_indext;
+  std::map<irep_idt, parameter_indext> parameters;
+
+  // Location-specific results are keyed on the location number, summaries
+  // of globals, parameters and functions on no_location.
+  static const unsigned no_location;
+  static const unsigned max_depth;
+  typedef std::pair<unsigned, irep_idt> keyt;
+
+  struct cache_entryt
+  {
+    object_mapt object_map;
+    bool complete;
+    unsigned depth;
+  };
+
+  typedef std::map<keyt, cache_entryt> cachet;
+  cachet cache;
+  unsigned depth;
+  unsigned lowest_dependency;
+
+  std::size_t queries;
+  std::size_t cache_hits;
+
+  void build(const goto_functionst &goto_functions);
+  void build(const irep_idt &function, const goto_programt &goto_program);
+
+  bool is_tracked(const irep_idt &identifier) const;
+  bool is_global(const irep_idt &identifier) const;
+
+  object_mapt lookup(const keyt &key);
+  object_mapt compute(const keyt &key);
+
+  object_mapt evaluate(unsigned location, const exprt &expr);
+  void collect_symbols(const exprt &expr, find_symbols_sett &dest) const;
+
+  object_mapt values_before(unsigned location, const irep_idt &identifier);
+  object_mapt local_values(unsigned location, const irep_idt &identifier);
+  bool assigns(const nodet &node, const irep_idt &identifier) const;
+  object_mapt values_assigned(unsigned location, const irep_idt &identifier);
+
+  object_mapt global_summary(const irep_idt &identifier);
+  object_mapt parameter_summary(const irep_idt &identifier);
+  object_mapt return_summary(const irep_idt &function);
+
+  bool may_call(unsigned location, const irep_idt &function);
+
+  void insert_values(object_mapt &dest, const value_setst::valuest &src);
+  void insert_unknown(object_mapt &dest, const typet &type);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_DEMAND_DRIVEN_VALUE_SETS_H
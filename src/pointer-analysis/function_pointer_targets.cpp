@@ -0,0 +1,63 @@
+/*******************************************************************\
+
+Module: Targets of Function Pointers from Value Sets
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Targets of Function Pointers from Value Sets
+
+#include "function_pointer_targets.h"
+
+#include <util/std_expr.h>
+
+void function_pointer_targets(
+  const goto_functionst &goto_functions,
+  value_setst &value_sets,
+  function_pointer_targetst &dest)
+{
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(target, f_it->second.body)
+    {
+      if(!target->is_function_call())
+        continue;
+
+      const exprt &function=to_code_function_call(target->code).function();
+
+      if(function.id()!=ID_dereference)
+        continue;
+
+      value_setst::valuest values;
+      value_sets.get_values(target, function.op0(), values);
+
+      std::set<irep_idt> functions;
+      bool complete=true;
+
+      for(const auto &value : values)
+      {
+        if(value.id()!=ID_object_descriptor)
+        {
+          complete=false;
+          break;
+        }
+
+        const exprt &object=to_object_descriptor_expr(value).root_object();
+
+        // null and other non-code objects cannot be called
+        if(object.id()==ID_symbol &&
+           object.type().id()==ID_code)
+          functions.insert(to_symbol_expr(object).get_identifier());
+        else if(object.id()==ID_unknown)
+        {
+          complete=false;
+          break;
+        }
+      }
+
+      // no function at all means that the analysis knows nothing
+      if(complete && !functions.empty())
+        dest[target]=functions;
+    }
+}
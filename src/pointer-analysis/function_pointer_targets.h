@@ -0,0 +1,27 @@
+/*******************************************************************\
+
+Module: Targets of Function Pointers from Value Sets
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Targets of Function Pointers from Value Sets
+
+#ifndef CPROVER_POINTER_ANALYSIS_FUNCTION_POINTER_TARGETS_H
+#define CPROVER_POINTER_ANALYSIS_FUNCTION_POINTER_TARGETS_H
+
+#include <goto-programs/remove_function_pointers.h>
+
+#include "value_sets.h"
+
+/// Asks \p value_sets for the targets of all indirect calls in
+/// \p goto_functions. A call is only added to \p dest if all its targets
+/// are known and include at least one function.
+void function_pointer_targets(
+  const goto_functionst &goto_functions,
+  value_setst &value_sets,
+  function_pointer_targetst &dest);
+
+#endif // CPROVER_POINTER_ANALYSIS_FUNCTION_POINTER_TARGETS_H
@@ -0,0 +1,472 @@
+/*******************************************************************\
+
+Module: Flow-Insensitive Points-To Pre-Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Flow-Insensitive Points-To Pre-Analysis
+
+#include "points_to_pre_analysis.h"
+
+#include <algorithm>
+
+#include <util/namespace.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/goto_functions.h>
+
+points_to_pre_analysist::points_to_pre_analysist(const namespacet &_ns):
+  ns(_ns),
+  temporary_count(0)
+{
+  // the unknown object may point to anything, including itself
+  unknown_node=nodes.number(exprt(ID_unknown));
+  add_constraint(constraint_kindt::ADDRESS_OF, unknown_node, unknown_node);
+}
+
+void points_to_pre_analysist::operator()(const goto_functionst &goto_functions)
+{
+  generate(goto_functions);
+  solve();
+}
+
+points_to_pre_analysist::nodet points_to_pre_analysist::symbol_node(
+  const symbol_exprt &expr)
+{
+  // use the type from the symbol table such that all occurrences
+  // of a symbol map to the same node
+  const symbolt *symbol;
+  if(!ns.lookup(expr.get_identifier(), symbol))
+    return nodes.number(symbol->symbol_expr());
+
+  return nodes.number(symbol_exprt(expr.get_identifier(), expr.type()));
+}
+
+points_to_pre_analysist::nodet points_to_pre_analysist::temporary_node()
+{
+  exprt temporary("points_to_temporary");
+  temporary.set(ID_identifier, temporary_count++);
+  return nodes.number(temporary);
+}
+
+points_to_pre_analysist::nodet points_to_pre_analysist::address_node(
+  nodet object)
+{
+  std::pair<std::map<nodet, nodet>::iterator, bool> entry=
+    address_nodes.insert(std::make_pair(object, 0));
+
+  if(entry.second)
+  {
+    entry.first->second=temporary_node();
+    add_constraint(
+      constraint_kindt::ADDRESS_OF, entry.first->second, object);
+  }
+
+  return entry.first->second;
+}
+
+points_to_pre_analysist::nodet points_to_pre_analysist::merge(
+  const nodest &values)
+{
+  if(values.size()==1)
+    return values.front();
+
+  const nodet result=temporary_node();
+
+  for(const auto &value : values)
+    add_constraint(constraint_kindt::COPY, result, value);
+
+  return result;
+}
+
+void points_to_pre_analysist::generate(const goto_functionst &goto_functions)
+{
+  // first set up the parameters and return values of all functions,
+  // calls may precede the body of the function they call
+  forall_goto_functions(f_it, goto_functions)
+  {
+    const nodet function=
+      symbol_node(symbol_exprt(f_it->first, f_it->second.type));
+    function_nodest &function_nodes=functions[function];
+
+    if(f_it->second.body_available())
+    {
+      exprt return_value("points_to_return_value");
+      return_value.set(ID_identifier, f_it->first);
+      function_nodes.return_value=nodes.number(return_value);
+    }
+    else
+      function_nodes.return_value=unknown_node;
+
+    for(const auto &parameter : f_it->second.type.parameters())
+    {
+      const irep_idt &identifier=parameter.get_identifier();
+
+      if(identifier.empty())
+        function_nodes.parameters.push_back(temporary_node());
+      else
+        function_nodes.parameters.push_back(
+          symbol_node(symbol_exprt(identifier, parameter.type())));
+    }
+  }
+
+  forall_goto_functions(f_it, goto_functions)
+  {
+    if(!f_it->second.body_available())
+      continue;
+
+    const nodet function=
+      symbol_node(symbol_exprt(f_it->first, f_it->second.type));
+
+    generate(functions[function].return_value, f_it->second.body);
+  }
+}
+
+void points_to_pre_analysist::generate(
+  nodet return_value,
+  const goto_programt &goto_program)
+{
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    const unsigned location=i_it->location_number;
+
+    if(i_it->is_assign())
+    {
+      const code_assignt &code_assign=to_code_assign(i_it->code);
+
+      nodest values;
+      rvalue(code_assign.rhs(), location, values);
+      assign(code_assign.lhs(), values, location);
+    }
+    else if(i_it->is_function_call())
+    {
+      generate_function_call(to_code_function_call(i_it->code), location);
+    }
+    else if(i_it->is_return())
+    {
+      const code_returnt &code_return=to_code_return(i_it->code);
+
+      if(!code_return.has_return_value())
+        continue;
+
+      nodest values;
+      rvalue(code_return.return_value(), location, values);
+
+      for(const auto &value : values)
+        add_constraint(constraint_kindt::COPY, return_value, value);
+    }
+  }
+}
+
+void points_to_pre_analysist::generate_function_call(
+  const code_function_callt &call,
+  unsigned location)
+{
+  nodest arguments;
+
+  for(const auto &argument : call.arguments())
+  {
+    nodest values;
+    rvalue(argument, location, values);
+    arguments.push_back(merge(values));
+  }
+
+  const exprt &function=call.function();
+
+  if(function.id()==ID_symbol)
+  {
+    function_mapt::const_iterator f_it=
+      functions.find(symbol_node(to_symbol_expr(function)));
+
+    // calls to functions we know nothing about return anything
+    if(f_it==functions.end())
+    {
+      if(call.lhs().is_not_nil())
+        assign(call.lhs(), nodest(1, unknown_node), location);
+      return;
+    }
+
+    const nodest &parameters=f_it->second.parameters;
+
+    for(std::size_t i=0; i<parameters.size() && i<arguments.size(); i++)
+      add_constraint(constraint_kindt::COPY, parameters[i], arguments[i]);
+
+    if(call.lhs().is_not_nil())
+      assign(call.lhs(), nodest(1, f_it->second.return_value), location);
+  }
+  else
+  {
+    nodest pointers;
+
+    if(function.id()==ID_dereference)
+      rvalue(to_dereference_expr(function).pointer(), location, pointers);
+    else
+      address_of(function, location, pointers);
+
+    indirect_callt indirect_call;
+    indirect_call.function=merge(pointers);
+    indirect_call.arguments.swap(arguments);
+    indirect_call.result=temporary_node();
+
+    if(call.lhs().is_not_nil())
+      assign(call.lhs(), nodest(1, indirect_call.result), location);
+
+    indirect_calls.push_back(indirect_call);
+  }
+}
+
+/// Collects the nodes whose targets \p expr may point to
+void points_to_pre_analysist::rvalue(
+  const exprt &expr,
+  unsigned location,
+  nodest &dest)
+{
+  if(expr.id()==ID_symbol)
+  {
+    dest.push_back(symbol_node(to_symbol_expr(expr)));
+  }
+  else if(expr.id()==ID_address_of)
+  {
+    address_of(to_address_of_expr(expr).object(), location, dest);
+  }
+  else if(expr.id()==ID_dereference)
+  {
+    nodest pointers;
+    rvalue(to_dereference_expr(expr).pointer(), location, pointers);
+
+    const nodet result=temporary_node();
+
+    for(const auto &pointer : pointers)
+      add_constraint(constraint_kindt::LOAD, result, pointer);
+
+    dest.push_back(result);
+  }
+  else if(expr.id()==ID_side_effect)
+  {
+    const irep_idt &statement=to_side_effect_expr(expr).get_statement();
+
+    if(statement==ID_malloc)
+    {
+      const typet &dynamic_type=
+        static_cast<const typet &>(expr.find(ID_C_cxx_alloc_type));
+
+      dynamic_object_exprt dynamic_object(dynamic_type);
+      dynamic_object.set_instance(location);
+      dynamic_object.valid()=true_exprt();
+
+      dest.push_back(address_node(nodes.number(dynamic_object)));
+    }
+    else if((statement==ID_cpp_new ||
+             statement==ID_cpp_new_array) &&
+            expr.type().id()==ID_pointer)
+    {
+      dynamic_object_exprt dynamic_object(expr.type().subtype());
+      dynamic_object.set_instance(location);
+      dynamic_object.valid()=true_exprt();
+
+      dest.push_back(address_node(nodes.number(dynamic_object)));
+    }
+    else if(expr.type().id()==ID_pointer)
+      dest.push_back(unknown_node);
+    else
+      forall_operands(it, expr)
+        rvalue(*it, location, dest);
+  }
+  else if(expr.id()==ID_typecast)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+
+    // integers converted to pointers may point anywhere
+    if(expr.type().id()==ID_pointer &&
+       op.type().id()!=ID_pointer &&
+       !op.is_constant())
+      dest.push_back(unknown_node);
+
+    rvalue(op, location, dest);
+  }
+  else if(expr.is_constant())
+  {
+    // null pointers and numbers do not point anywhere
+  }
+  else
+  {
+    forall_operands(it, expr)
+      rvalue(*it, location, dest);
+  }
+}
+
+/// Collects nodes that point to the object \p object denotes
+void points_to_pre_analysist::address_of(
+  const exprt &object,
+  unsigned location,
+  nodest &dest)
+{
+  if(object.id()==ID_symbol)
+  {
+    dest.push_back(address_node(symbol_node(to_symbol_expr(object))));
+  }
+  else if(object.id()==ID_dereference)
+  {
+    rvalue(to_dereference_expr(object).pointer(), location, dest);
+  }
+  else if(object.id()==ID_member ||
+          object.id()==ID_index ||
+          object.id()==ID_typecast ||
+          object.id()==ID_byte_extract_little_endian ||
+          object.id()==ID_byte_extract_big_endian)
+  {
+    // fields and elements are not distinguished from their parent
+    address_of(object.op0(), location, dest);
+  }
+  else if(object.id()==ID_if)
+  {
+    address_of(to_if_expr(object).true_case(), location, dest);
+    address_of(to_if_expr(object).false_case(), location, dest);
+  }
+  else
+    dest.push_back(address_node(nodes.number(object)));
+}
+
+void points_to_pre_analysist::assign(
+  const exprt &lhs,
+  const nodest &values,
+  unsigned location)
+{
+  if(values.empty())
+    return;
+
+  if(lhs.id()==ID_symbol)
+  {
+    const nodet dest=symbol_node(to_symbol_expr(lhs));
+
+    for(const auto &value : values)
+      add_constraint(constraint_kindt::COPY, dest, value);
+  }
+  else if(lhs.id()==ID_dereference)
+  {
+    nodest pointers;
+    rvalue(to_dereference_expr(lhs).pointer(), location, pointers);
+
+    const nodet value=merge(values);
+
+    for(const auto &pointer : pointers)
+      add_constraint(constraint_kindt::STORE, pointer, value);
+  }
+  else if(lhs.id()==ID_member ||
+          lhs.id()==ID_index ||
+          lhs.id()==ID_typecast ||
+          lhs.id()==ID_byte_extract_little_endian ||
+          lhs.id()==ID_byte_extract_big_endian)
+  {
+    assign(lhs.op0(), values, location);
+  }
+  else if(lhs.id()==ID_if)
+  {
+    assign(to_if_expr(lhs).true_case(), values, location);
+    assign(to_if_expr(lhs).false_case(), values, location);
+  }
+
+  // assignments to anything else, e.g., the null object, have no effect
+}
+
+void points_to_pre_analysist::get_values(
+  goto_programt::const_targett l,
+  const exprt &expr,
+  value_setst::valuest &dest)
+{
+  nodest objects;
+  evaluate(expr, objects);
+
+  std::sort(objects.begin(), objects.end());
+  objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+
+  for(const auto &object_node : objects)
+  {
+    const exprt &object=nodes[object_node];
+
+    if(object.id()==ID_unknown)
+    {
+      dest.push_back(exprt(ID_unknown, expr.type()));
+      continue;
+    }
+
+    object_descriptor_exprt object_descriptor;
+    object_descriptor.object()=object;
+    object_descriptor.type()=object.type();
+    dest.push_back(object_descriptor);
+  }
+}
+
+/// Collects the objects \p expr may point to
+void points_to_pre_analysist::evaluate(const exprt &expr, nodest &dest)
+{
+  if(expr.id()==ID_symbol)
+  {
+    get_points_to(symbol_node(to_symbol_expr(expr)), dest);
+  }
+  else if(expr.id()==ID_address_of)
+  {
+    evaluate_address_of(to_address_of_expr(expr).object(), dest);
+  }
+  else if(expr.id()==ID_dereference)
+  {
+    nodest pointers;
+    evaluate(to_dereference_expr(expr).pointer(), pointers);
+
+    for(const auto &pointer : pointers)
+      get_points_to(pointer, dest);
+  }
+  else if(expr.id()==ID_side_effect)
+  {
+    if(expr.type().id()==ID_pointer)
+      dest.push_back(unknown_node);
+  }
+  else if(expr.id()==ID_typecast)
+  {
+    const exprt &op=to_typecast_expr(expr).op();
+
+    if(expr.type().id()==ID_pointer &&
+       op.type().id()!=ID_pointer &&
+       !op.is_constant())
+      dest.push_back(unknown_node);
+
+    evaluate(op, dest);
+  }
+  else if(!expr.is_constant())
+  {
+    forall_operands(it, expr)
+      evaluate(*it, dest);
+  }
+}
+
+void points_to_pre_analysist::evaluate_address_of(
+  const exprt &object,
+  nodest &dest)
+{
+  if(object.id()==ID_symbol)
+  {
+    dest.push_back(symbol_node(to_symbol_expr(object)));
+  }
+  else if(object.id()==ID_dereference)
+  {
+    evaluate(to_dereference_expr(object).pointer(), dest);
+  }
+  else if(object.id()==ID_member ||
+          object.id()==ID_index ||
+          object.id()==ID_typecast ||
+          object.id()==ID_byte_extract_little_endian ||
+          object.id()==ID_byte_extract_big_endian)
+  {
+    evaluate_address_of(object.op0(), dest);
+  }
+  else if(object.id()==ID_if)
+  {
+    evaluate_address_of(to_if_expr(object).true_case(), dest);
+    evaluate_address_of(to_if_expr(object).false_case(), dest);
+  }
+  else
+    dest.push_back(nodes.number(object));
+}
@@ -0,0 +1,139 @@
+/*******************************************************************\
+
+Module: Flow-Insensitive Points-To Pre-Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Flow-Insensitive Points-To Pre-Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_POINTS_TO_PRE_ANALYSIS_H
+#define CPROVER_POINTER_ANALYSIS_POINTS_TO_PRE_ANALYSIS_H
+
+#include <map>
+#include <vector>
+
+#include <util/irep_hash.h>
+#include <util/numbering.h>
+
+#include "value_sets.h"
+
+class goto_functionst;
+class namespacet;
+
+/// Base class of the fast, flow- and context-insensitive points-to
+/// analyses. The program is translated into constraints over nodes:
+/// abstract objects (variables, allocation sites, functions) and
+/// auxiliary nodes for return values and intermediate results. Fields and
+/// array elements are not distinguished. Solving the constraints is left
+/// to the subclasses.
+class points_to_pre_analysist:public value_setst
+{
+public:
+  explicit points_to_pre_analysist(const namespacet &_ns);
+
+  void operator()(const goto_functionst &goto_functions);
+
+  // the answer does not depend on the location
+  virtual void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    value_setst::valuest &dest);
+
+  typedef std::size_t nodet;
+  typedef std::vector<nodet> nodest;
+
+  std::size_t number_of_nodes() const
+  {
+    return nodes.size();
+  }
+
+  std::size_t number_of_constraints() const
+  {
+    return constraints.size();
+  }
+
+protected:
+  const namespacet &ns;
+
+  hash_numbering<exprt, irep_hash> nodes;
+  std::size_t temporary_count;
+  nodet unknown_node;
+
+  // ADDRESS_OF: dest points to src
+  // COPY:       dest points to everything src points to
+  // LOAD:       dest points to everything *src points to
+  // STORE:      *dest points to everything src points to
+  enum class constraint_kindt { ADDRESS_OF, COPY, LOAD, STORE };
+
+  struct constraintt
+  {
+    constraint_kindt kind;
+    nodet dest;
+    nodet src;
+
+    constraintt(constraint_kindt _kind, nodet _dest, nodet _src):
+      kind(_kind), dest(_dest), src(_src)
+    {
+    }
+  };
+
+  typedef std::vector<constraintt> constraintst;
+  constraintst constraints;
+
+  // Indirect calls are resolved while solving: the arguments are copied to
+  // the parameters and the return value to the result of every function
+  // the function pointer turns out to point to.
+  struct indirect_callt
+  {
+    nodet function;
+    nodest arguments;
+    nodet result;
+  };
+
+  typedef std::vector<indirect_callt> indirect_callst;
+  indirect_callst indirect_calls;
+
+  struct function_nodest
+  {
+    nodest parameters;
+    nodet return_value;
+  };
+
+  // keyed on the node of the function symbol
+  typedef std::map<nodet, function_nodest> function_mapt;
+  function_mapt functions;
+
+  // nodes that point to exactly one object, keyed on the object
+  std::map<nodet, nodet> address_nodes;
+
+  virtual void solve()=0;
+  virtual void get_points_to(nodet node, nodest &dest) const=0;
+
+  void add_constraint(constraint_kindt kind, nodet dest, nodet src)
+  {
+    constraints.push_back(constraintt(kind, dest, src));
+  }
+
+  nodet symbol_node(const symbol_exprt &expr);
+  nodet temporary_node();
+  nodet address_node(nodet object);
+  nodet merge(const nodest &values);
+
+  void generate(const goto_functionst &goto_functions);
+  void generate(nodet return_value, const goto_programt &goto_program);
+  void generate_function_call(
+    const code_function_callt &call,
+    unsigned location);
+
+  void rvalue(const exprt &expr, unsigned location, nodest &dest);
+  void address_of(const exprt &object, unsigned location, nodest &dest);
+  void assign(const exprt &lhs, const nodest &values, unsigned location);
+
+  void evaluate(const exprt &expr, nodest &dest);
+  void evaluate_address_of(const exprt &object, nodest &dest);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_POINTS_TO_PRE_ANALYSIS_H
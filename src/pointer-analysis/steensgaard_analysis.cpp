@@ -0,0 +1,224 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#include "steensgaard_analysis.h"
+
+#include <limits>
+
+const steensgaard_analysist::nodet steensgaard_analysist::no_node=
+  std::numeric_limits<steensgaard_analysist::nodet>::max();
+
+void steensgaard_analysist::solve()
+{
+  const std::size_t size=nodes.size();
+
+  classes.resize(size);
+  pointees.resize(size, no_node);
+  objects.resize(size);
+
+  for(const auto &constraint : constraints)
+    if(constraint.kind==constraint_kindt::ADDRESS_OF &&
+       objects[constraint.src].empty())
+      objects[constraint.src].push_back(constraint.src);
+
+  for(const auto &constraint : constraints)
+  {
+    const nodet dest=constraint.dest;
+    const nodet src=constraint.src;
+
+    switch(constraint.kind)
+    {
+    case constraint_kindt::ADDRESS_OF:
+      unify(pointee(dest), src);
+      break;
+    case constraint_kindt::COPY:
+      unify(pointee(dest), pointee(src));
+      break;
+    case constraint_kindt::LOAD:
+      {
+        const nodet loaded=pointee(pointee(src));
+        unify(pointee(dest), loaded);
+      }
+      break;
+    case constraint_kindt::STORE:
+      {
+        const nodet stored=pointee(pointee(dest));
+        unify(stored, pointee(src));
+      }
+      break;
+    }
+  }
+
+  while(resolve_indirect_calls() || resolve_unknown_stores()) {}
+}
+
+void steensgaard_analysist::get_points_to(nodet node, nodest &dest) const
+{
+  // nodes created after solving do not point anywhere
+  if(node>=pointees.size())
+    return;
+
+  const nodet target=pointees[representative(node)];
+
+  if(target==no_node)
+    return;
+
+  const nodest &target_objects=objects[representative(target)];
+  dest.insert(dest.end(), target_objects.begin(), target_objects.end());
+}
+
+/// \return the class \p node points to, which is created if there is
+///   none yet
+steensgaard_analysist::nodet steensgaard_analysist::pointee(nodet node)
+{
+  const nodet root=representative(node);
+
+  if(pointees[root]==no_node)
+  {
+    const nodet target=temporary_node();
+
+    classes.resize(nodes.size());
+    pointees.resize(nodes.size(), no_node);
+    objects.resize(nodes.size());
+
+    pointees[root]=target;
+  }
+
+  return pointees[root];
+}
+
+/// Merges the classes of \p a and \p b, and recursively the classes they
+/// point to
+void steensgaard_analysist::unify(nodet a, nodet b)
+{
+  std::vector<std::pair<nodet, nodet>> worklist;
+  worklist.push_back(std::make_pair(a, b));
+
+  while(!worklist.empty())
+  {
+    a=representative(worklist.back().first);
+    b=representative(worklist.back().second);
+    worklist.pop_back();
+
+    if(a==b)
+      continue;
+
+    const nodet a_pointee=pointees[a];
+    const nodet b_pointee=pointees[b];
+
+    classes.make_union(a, b);
+
+    const nodet root=representative(a);
+    const nodet other=root==a?b:a;
+
+    objects[root].insert(
+      objects[root].end(), objects[other].begin(), objects[other].end());
+    nodest().swap(objects[other]);
+
+    if(a_pointee==no_node)
+      pointees[root]=b_pointee;
+    else
+    {
+      pointees[root]=a_pointee;
+
+      if(b_pointee!=no_node)
+        worklist.push_back(std::make_pair(a_pointee, b_pointee));
+    }
+  }
+}
+
+/// Binds the parameters and return values of the functions that
+/// indirect calls may now reach
+/// \return true if a new function was bound
+bool steensgaard_analysist::resolve_indirect_calls()
+{
+  bool new_binding=false;
+
+  for(std::size_t i=0; i<indirect_calls.size(); i++)
+  {
+    const indirect_callt &indirect_call=indirect_calls[i];
+    const nodet target=pointees[representative(indirect_call.function)];
+
+    if(target==no_node)
+      continue;
+
+    // binding unifies classes, hence work on a copy
+    const nodest functions_called=objects[representative(target)];
+
+    for(const auto &function : functions_called)
+    {
+      if(!resolved_calls.insert(std::make_pair(i, function)).second)
+        continue;
+
+      function_mapt::const_iterator f_it=functions.find(function);
+
+      if(f_it==functions.end())
+        continue;
+
+      new_binding=true;
+
+      const nodest &parameters=f_it->second.parameters;
+
+      for(std::size_t p=0;
+          p<parameters.size() && p<indirect_call.arguments.size();
+          p++)
+      {
+        const nodet argument=pointee(indirect_call.arguments[p]);
+        unify(pointee(parameters[p]), argument);
+      }
+
+      const nodet return_value=pointee(f_it->second.return_value);
+      unify(pointee(indirect_call.result), return_value);
+    }
+  }
+
+  return new_binding;
+}
+
+/// A store through a pointer to the unknown object may write to any
+/// object, hence the classes all objects point to are unified with that
+/// of the unknown object, which holds what was stored
+/// \return true if the classes were unified
+bool steensgaard_analysist::resolve_unknown_stores()
+{
+  if(unknown_stores_resolved)
+    return false;
+
+  const nodet unknown=representative(unknown_node);
+  bool store_through_unknown=false;
+
+  for(const auto &constraint : constraints)
+  {
+    if(constraint.kind!=constraint_kindt::STORE)
+      continue;
+
+    const nodet target=pointees[representative(constraint.dest)];
+
+    if(target!=no_node && representative(target)==unknown)
+    {
+      store_through_unknown=true;
+      break;
+    }
+  }
+
+  if(!store_through_unknown)
+    return false;
+
+  unknown_stores_resolved=true;
+
+  const nodet unknown_pointee=pointee(unknown_node);
+
+  for(const auto &constraint : constraints)
+    if(constraint.kind==constraint_kindt::ADDRESS_OF)
+      unify(pointee(constraint.src), unknown_pointee);
+
+  return true;
+}
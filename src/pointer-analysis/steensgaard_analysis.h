@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_STEENSGAARD_ANALYSIS_H
+#define CPROVER_POINTER_ANALYSIS_STEENSGAARD_ANALYSIS_H
+
+#include <set>
+
+#include <util/union_find.h>
+
+#include "points_to_pre_analysis.h"
+
+/// Steensgaard-style analysis. Nodes are partitioned into equivalence
+/// classes, each of which points to at most one other class; every
+/// constraint unifies classes. This runs in almost linear time, at the
+/// expense of precision compared to andersen_analysist. Once there is a
+/// store through a pointer to the unknown object, all objects are assumed
+/// to point to whatever the unknown object does.
+class steensgaard_analysist:public points_to_pre_analysist
+{
+public:
+  explicit steensgaard_analysist(const namespacet &_ns):
+    points_to_pre_analysist(_ns),
+    unknown_stores_resolved(false)
+  {
+  }
+
+protected:
+  unsigned_union_find classes;
+
+  // the class pointed to, indexed by representative
+  std::vector<nodet> pointees;
+
+  // the objects in each class, indexed by representative
+  std::vector<nodest> objects;
+
+  // pairs of indirect call and function already bound
+  std::set<std::pair<std::size_t, nodet>> resolved_calls;
+
+  bool unknown_stores_resolved;
+
+  static const nodet no_node;
+
+  virtual void solve();
+  virtual void get_points_to(nodet node, nodest &dest) const;
+
+  nodet representative(nodet node) const
+  {
+    return classes.find(node);
+  }
+
+  nodet pointee(nodet node);
+  void unify(nodet a, nodet b);
+  bool resolve_indirect_calls();
+  bool resolve_unknown_stores();
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_STEENSGAARD_ANALYSIS_H
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "value_set.h"
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 
@@ -36,6 +37,127 @@ Author: Daniel Kroening, kroening@kroening.com
 const value_sett::object_map_dt value_sett::object_map_dt::blank;
 object_numberingt value_sett::object_numbering;
 
+value_sett::object_map_dt::entriest::const_iterator
+value_sett::object_map_dt::lower_bound(unsigned n) const
+{
+  return std::lower_bound(
+    entries.begin(),
+    entries.end(),
+    n,
+    [](const value_type &entry, unsigned key) { return entry.first<key; });
+}
+
+value_sett::object_map_dt::entriest::iterator
+value_sett::object_map_dt::lower_bound(unsigned n)
+{
+  return std::lower_bound(
+    entries.begin(),
+    entries.end(),
+    n,
+    [](const value_type &entry, unsigned key) { return entry.first<key; });
+}
+
+void value_sett::object_map_dt::merge_pending()
+{
+  if(pending.empty())
+    return;
+
+  entriest result;
+  result.reserve(entries.size()+pending.size());
+
+  entriest::const_iterator e_it=entries.begin();
+  pendingt::const_iterator p_it=pending.begin();
+
+  while(e_it!=entries.end() || p_it!=pending.end())
+  {
+    if(p_it==pending.end() ||
+       (e_it!=entries.end() && e_it->first<p_it->first))
+    {
+      result.push_back(*e_it);
+      ++e_it;
+    }
+    else
+    {
+      // the keys are disjoint, see operator[]
+      assert(e_it==entries.end() || p_it->first<e_it->first);
+      result.push_back(p_it->second);
+      ++p_it;
+    }
+  }
+
+  entries.swap(result);
+  pending.clear();
+}
+
+value_sett::object_map_dt::const_iterator
+value_sett::object_map_dt::find(unsigned n) const
+{
+  // the iterator also needs the position of n in the other sequence
+  entriest::const_iterator e_it=lower_bound(n);
+  pendingt::const_iterator p_it=pending.lower_bound(n);
+
+  if((e_it!=entries.end() && e_it->first==n) ||
+     (p_it!=pending.end() && p_it->first==n))
+    return const_iterator(e_it, entries.end(), p_it, pending.end());
+
+  return end();
+}
+
+const value_sett::objectt *value_sett::object_map_dt::get(unsigned n) const
+{
+  entriest::const_iterator it=lower_bound(n);
+
+  if(it!=entries.end() && it->first==n)
+    return &it->second;
+
+  pendingt::const_iterator p_it=pending.find(n);
+
+  return p_it==pending.end()?nullptr:&p_it->second.second;
+}
+
+value_sett::objectt &value_sett::object_map_dt::operator[](unsigned n)
+{
+  // entries are frequently added in order
+  if(pending.empty() && (entries.empty() || entries.back().first<n))
+  {
+    entries.push_back(value_type(n, objectt()));
+    return entries.back().second;
+  }
+
+  entriest::iterator it=lower_bound(n);
+
+  if(it!=entries.end() && it->first==n)
+    return it->second;
+
+  pendingt::iterator p_it=pending.find(n);
+
+  if(p_it!=pending.end())
+    return p_it->second.second;
+
+  // The pending entries are merged once there are as many as sorted ones,
+  // which makes the cost of the merges linear in the final size.
+  if(pending.size()>=std::max<std::size_t>(entries.size(), 16))
+    merge_pending();
+
+  value_type &entry=pending[n];
+  entry.first=n;
+  return entry.second;
+}
+
+std::size_t value_sett::object_map_dt::erase(unsigned n)
+{
+  if(pending.erase(n)!=0)
+    return 1;
+
+  entriest::iterator it=lower_bound(n);
+
+  if(it==entries.end() || it->first!=n)
+    return 0;
+
+  entries.erase(it);
+  return 1;
+}
+
 bool value_sett::field_sensitive(
   const irep_idt &id,
   const typet &type,
@@ -74,18 +196,18 @@ bool value_sett::insert(
   unsigned n,
   const objectt &object) const
 {
-  object_map_dt::const_iterator entry=dest.read().find(n);
+  const objectt *entry=dest.read().get(n);
 
-  if(entry==dest.read().end())
+  if(entry==nullptr)
   {
     // new
     dest.write()[n]=object;
     return true;
   }
-  else if(!entry->second.offset_is_set)
+  else if(!entry->offset_is_set)
     return false; // no change
   else if(object.offset_is_set &&
-          entry->second.offset==object.offset)
+          entry->offset==object.offset)
     return false; // no change
   else
   {
@@ -243,19 +365,83 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
   return result;
 }
 
+/// Merges the two sorted maps; dest is only written to, and thus only
+/// loses its sharing, if src adds something new.
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  const object_map_dt &src_map=src.read();
+  const object_map_dt &dest_map=dest.read();
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  if(src_map.empty() || dest.get_d()==src.get_d())
+    return false;
+
+  if(dest_map.empty())
   {
-    if(insert(dest, it))
-      result=true;
+    dest=src;
+    return true;
   }
 
-  return result;
+  // first see whether there is anything to do
+  object_map_dt::const_iterator d_it=dest_map.begin();
+  object_map_dt::const_iterator s_it=src_map.begin();
+  bool changed=false;
+
+  while(s_it!=src_map.end() && !changed)
+  {
+    if(d_it==dest_map.end() || s_it->first<d_it->first)
+      changed=true;
+    else if(d_it->first<s_it->first)
+      d_it++;
+    else
+    {
+      changed=d_it->second.offset_is_set &&
+              (!s_it->second.offset_is_set ||
+               d_it->second.offset!=s_it->second.offset);
+      d_it++;
+      s_it++;
+    }
+  }
+
+  if(!changed)
+    return false;
+
+  object_map_dt result;
+  result.reserve(dest_map.size()+src_map.size());
+
+  d_it=dest_map.begin();
+  s_it=src_map.begin();
+
+  while(d_it!=dest_map.end() || s_it!=src_map.end())
+  {
+    if(s_it==src_map.end() ||
+       (d_it!=dest_map.end() && d_it->first<s_it->first))
+    {
+      result.push_back(*d_it);
+      d_it++;
+    }
+    else if(d_it==dest_map.end() || s_it->first<d_it->first)
+    {
+      result.push_back(*s_it);
+      s_it++;
+    }
+    else
+    {
+      object_map_dt::value_type entry=*d_it;
+
+      if(!s_it->second.offset_is_set ||
+         d_it->second.offset!=s_it->second.offset)
+        entry.second.offset_is_set=false;
+
+      result.push_back(entry);
+
+      d_it++;
+      s_it++;
+    }
+  }
+
+  dest.write().swap(result);
+
+  return true;
 }
 
 bool value_sett::eval_pointer_offset(
@@ -551,7 +737,7 @@ void value_sett::get_value_set_rec(
         else
         {
           // use as is
-          dest.write().insert(tmp.read().begin(), tmp.read().end());
+          make_union(dest, tmp);
         }
       }
     }
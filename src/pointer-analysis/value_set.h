@@ -12,7 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 #define CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <map>
 #include <set>
+#include <vector>
 
 #include <util/mp_arith.h>
 #include <util/reference_counting.h>
@@ -58,11 +63,154 @@ public:
     { return offset_is_set && offset.is_zero(); }
   };
 
-  class object_map_dt:public std::map<unsigned, objectt>
+  /// Maps object numbers to offsets. Most maps have only a handful of
+  /// entries, so rather than a tree they are kept in a vector sorted by
+  /// object number: one allocation per map, and the union of two maps is a
+  /// linear merge. Entries that arrive out of order are collected in a
+  /// small tree first and merged into the vector in one go once the tree
+  /// has grown as large as the vector; this keeps a series of out-of-order
+  /// insertions from being quadratic. Reading never merges: the iterators
+  /// visit both in order, hence a map can be read while it is shared and
+  /// looked up while it is being iterated over.
+  class object_map_dt
   {
   public:
+    typedef std::pair<unsigned, objectt> value_type;
+    typedef std::vector<value_type> entriest;
+
+    // the entries that arrived out of order, by object number
+    typedef std::map<unsigned, value_type> pendingt;
+
+    /// Visits the sorted and the pending entries by object number
+    class const_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef object_map_dt::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type *pointer;
+      typedef const value_type &reference;
+
+      const_iterator()
+      {
+      }
+
+      const_iterator(
+        entriest::const_iterator _e_it,
+        entriest::const_iterator _e_end,
+        pendingt::const_iterator _p_it,
+        pendingt::const_iterator _p_end):
+        e_it(_e_it),
+        e_end(_e_end),
+        p_it(_p_it),
+        p_end(_p_end)
+      {
+      }
+
+      reference operator*() const
+      {
+        return from_pending()?p_it->second:*e_it;
+      }
+
+      pointer operator->() const
+      {
+        return &**this;
+      }
+
+      const_iterator &operator++()
+      {
+        if(from_pending())
+          ++p_it;
+        else
+          ++e_it;
+        return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+        const_iterator tmp(*this);
+        ++*this;
+        return tmp;
+      }
+
+      bool operator==(const const_iterator &other) const
+      {
+        return e_it==other.e_it && p_it==other.p_it;
+      }
+
+      bool operator!=(const const_iterator &other) const
+      {
+        return !(*this==other);
+      }
+
+    protected:
+      entriest::const_iterator e_it, e_end;
+      pendingt::const_iterator p_it, p_end;
+
+      // the object numbers of the two are disjoint
+      bool from_pending() const
+      {
+        return p_it!=p_end && (e_it==e_end || p_it->first<e_it->first);
+      }
+    };
+
     object_map_dt() {}
     static const object_map_dt blank;
+
+    const_iterator begin() const
+    {
+      return const_iterator(
+        entries.begin(), entries.end(), pending.begin(), pending.end());
+    }
+
+    const_iterator end() const
+    {
+      return const_iterator(
+        entries.end(), entries.end(), pending.end(), pending.end());
+    }
+
+    std::size_t size() const { return entries.size()+pending.size(); }
+    bool empty() const { return entries.empty() && pending.empty(); }
+    void clear() { entries.clear(); pending.clear(); }
+
+    const_iterator find(unsigned n) const;
+
+    /// Looks up an entry without constructing an iterator
+    /// \return the entry for object \p n, or nullptr if there is none
+    const objectt *get(unsigned n) const;
+
+    objectt &operator[](unsigned n);
+
+    /// \return the number of entries removed, i.e., 0 or 1
+    std::size_t erase(unsigned n);
+
+    void swap(object_map_dt &other)
+    {
+      entries.swap(other.entries);
+      pending.swap(other.pending);
+    }
+
+    /// Appends an entry; the caller needs to maintain the order.
+    void push_back(const value_type &entry)
+    {
+      merge_pending();
+      assert(entries.empty() || entries.back().first<entry.first);
+      entries.push_back(entry);
+    }
+
+    void reserve(std::size_t n)
+    {
+      entries.reserve(n);
+    }
+
+  protected:
+    entriest entries;
+    pendingt pending;
+
+    void merge_pending();
+
+    entriest::const_iterator lower_bound(unsigned n) const;
+    entriest::iterator lower_bound(unsigned n);
   };
 
   exprt to_expr(object_map_dt::const_iterator it) const;
@@ -11,6 +11,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cover_goals.h"
 
+#include <algorithm>
+
+#include <util/arith_tools.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
 #include <util/threeval.h>
 
 #include "literal_expr.h"
@@ -20,11 +25,15 @@ cover_goalst::~cover_goalst()
 }
 
 /// Mark goals that are covered
-void cover_goalst::mark()
+/// \param extended: whether the assignment extends the previous one
+void cover_goalst::mark(bool extended)
 {
   // notify observers
   for(const auto &o : observers)
-    o->satisfying_assignment();
+    if(extended)
+      o->satisfying_assignment_extended();
+    else
+      o->satisfying_assignment();
 
   for(auto &g : goals)
     if(g.status==goalt::statust::UNKNOWN &&
@@ -58,6 +67,87 @@ void cover_goalst::constraint()
   prop_conv.set_to_true(disjunction(disjuncts));
 }
 
+/// Extend the current satisfying assignment by further goals. The goals
+/// that the assignment satisfies are kept as assumptions, and a number of
+/// the goals that are still unknown is required through an assumption on
+/// their count, such that the formula itself is not constrained. Each
+/// solver call asks for half of the remaining goals at first; the number
+/// is halved whenever it cannot be reached, and the extension stops once
+/// not even one further goal fits. Thus a test that satisfies many goals
+/// is found with few calls, rather than with one call per goal.
+void cover_goalst::extend()
+{
+  if(!prop_conv.has_set_assumptions())
+    return;
+
+  // the goals the assignment does not satisfy, see mark()
+  bvt remaining;
+
+  for(const auto &g : goals)
+    if(g.status==goalt::statust::UNKNOWN && !g.condition.is_constant())
+      remaining.push_back(g.condition);
+
+  if(remaining.empty())
+    return;
+
+  const unsignedbv_typet count_type(
+    integer2size_t(address_bits(remaining.size()+1)));
+
+  exprt count(ID_plus, count_type);
+
+  for(const auto &l : remaining)
+    count.copy_to_operands(typecast_exprt(literal_exprt(l), count_type));
+
+  if(count.operands().size()==1)
+    count=count.op0();
+
+  std::size_t satisfied=0;
+  std::size_t wanted=(remaining.size()+1)/2;
+
+  while(wanted>0)
+  {
+    bvt assumptions;
+
+    for(const auto &g : goals)
+      if(!g.condition.is_constant() &&
+         prop_conv.l_get(g.condition).is_true())
+        assumptions.push_back(g.condition);
+
+    literalt enough=prop_conv.convert(
+      binary_relation_exprt(
+        count, ID_ge, from_integer(satisfied+wanted, count_type)));
+
+    if(!enough.is_constant())
+    {
+      prop_conv.set_frozen(enough);
+      assumptions.push_back(enough);
+    }
+
+    prop_conv.set_assumptions(assumptions);
+
+    _iterations++;
+    decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+
+    if(dec_result==decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      mark(true);
+
+      satisfied=0;
+      for(const auto &l : remaining)
+        if(prop_conv.l_get(l).is_true())
+          satisfied++;
+
+      wanted=std::min(wanted, remaining.size()-satisfied);
+    }
+    else if(dec_result==decision_proceduret::resultt::D_UNSATISFIABLE)
+      wanted/=2;
+    else
+      break;
+  }
+
+  prop_conv.set_assumptions(bvt());
+}
+
 /// Build clause
 void cover_goalst::freeze_goal_variables()
 {
@@ -96,6 +186,9 @@ decision_proceduret::resultt cover_goalst::operator()()
     case decision_proceduret::resultt::D_SATISFIABLE:
       // mark the goals we got, and notify observers
       mark();
+
+      if(extend_assignments)
+        extend();
       break;
 
     default:
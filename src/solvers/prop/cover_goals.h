@@ -22,6 +22,7 @@ class cover_goalst:public messaget
 {
 public:
   explicit cover_goalst(prop_convt &_prop_conv):
+    extend_assignments(false),
     _number_covered(0),
     _iterations(0),
     prop_conv(_prop_conv)
@@ -33,6 +34,12 @@ public:
   // returns result of last run on success
   decision_proceduret::resultt operator()();
 
+  // When set, each satisfying assignment is extended by further goals,
+  // using assumptions on the number of goals satisfied, until no other
+  // goal can be added. This yields fewer assignments, each of which
+  // covers more goals, with fewer solver calls per goal.
+  bool extend_assignments;
+
   // the goals
 
   struct goalt
@@ -81,6 +88,13 @@ public:
   public:
     virtual void goal_covered(const goalt &) { }
     virtual void satisfying_assignment() { }
+
+    // the previous satisfying assignment has been replaced by one
+    // that satisfies the same goals, and more
+    virtual void satisfying_assignment_extended()
+    {
+      satisfying_assignment();
+    }
   };
 
   void register_observer(observert &o)
@@ -97,7 +111,8 @@ protected:
   observerst observers;
 
 private:
-  void mark();
+  void mark(bool extended=false);
+  void extend();
   void constraint();
   void freeze_goal_variables();
 };
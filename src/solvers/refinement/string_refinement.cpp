@@ -26,11 +26,48 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 #include <solvers/sat/satcheck.h>
 #include <langapi/language_util.h>
 
+// Will be used to visit an expression and return the index used
+// with the given char array
+class find_index_visitort: public const_expr_visitort
+{
+private:
+  const exprt &str_;
+
+public:
+  explicit find_index_visitort(const exprt &str): str_(str) {}
+
+  void operator()(const exprt &expr)
+  {
+    if(expr.id()==ID_index)
+    {
+      const index_exprt &i=to_index_expr(expr);
+      if(i.array()==str_)
+        throw i.index();
+    }
+  }
+};
+
+/// find an index used in the expression for str, for instance with arguments
+/// (str[k] == 'a') and str, the function should return k
+/// \par parameters: a formula expr and a char array str
+/// \return an index expression
+static exprt find_index(const exprt &expr, const exprt &str)
+{
+  find_index_visitort v1(str);
+  try
+  {
+    expr.visit(v1);
+    return nil_exprt();
+  }
+  catch (exprt i) { return i; }
+}
+
 string_refinementt::string_refinementt(
   const namespacet &_ns, propt &_prop, unsigned refinement_bound):
   supert(_ns, _prop),
   use_counter_example(false),
-  initial_loop_bound(refinement_bound)
+  initial_loop_bound(refinement_bound),
+  iterations(0)
 { }
 
 /// determine which language should be used
@@ -72,19 +109,53 @@ void string_refinementt::add_instantiations()
       debug() << from_expr(j) << "; ";
     debug() << "}"  << eom;
 
-    for(const auto &j : i.second)
+    for(const auto &ua : universal_axioms)
     {
-      const exprt &val=j;
+      // the index of s in the axiom is the same for all values
+      const exprt idx=find_index(ua.body(), s);
 
-      for(const auto &ua : universal_axioms)
+      for(const auto &val : i.second)
       {
-        exprt lemma=instantiate(ua, s, val);
+        exprt lemma=instantiate(ua, idx, val);
         add_lemma(lemma);
       }
     }
   }
 }
 
+/// instantiate the not_contains axioms with the pairs of indices that have
+/// not been used before, i.e., where one of them is in the current index set
+void string_refinementt::instantiate_not_contains()
+{
+  debug() << "instantiating NOT_CONTAINS constraints" << eom;
+  for(unsigned i=0; i<not_contains_axioms.size(); i++)
+  {
+    debug() << "constraint " << i << eom;
+    std::list<exprt> lemmas;
+    instantiate_not_contains(not_contains_axioms[i], lemmas);
+    for(const exprt &lemma : lemmas)
+      add_lemma(lemma);
+  }
+}
+
+/// output the statistics of a refinement iteration
+void string_refinementt::report_iteration(
+  const time_periodt &solver,
+  const time_periodt &check,
+  const time_periodt &instantiation)
+{
+  std::size_t index_set_size=0;
+  for(const auto &i : index_set)
+    index_set_size+=i.second.size();
+
+  statistics() << "string refinement iteration " << iterations
+               << ": solver " << solver << "s"
+               << ", check " << check << "s"
+               << ", instantiation " << instantiation << "s"
+               << ", " << index_set_size << " indices"
+               << ", " << seen_instances.size() << " lemmas" << eom;
+}
+
 /// if the expression is a function application, we convert it using our own
 /// convert_function_application method
 /// \par parameters: an expression
@@ -229,58 +300,64 @@ decision_proceduret::resultt string_refinementt::dec_solve()
   update_index_set(cur);
   cur.clear();
   add_instantiations();
+  instantiate_not_contains();
 
   while((initial_loop_bound--)>0)
   {
+    iterations++;
+
+    absolute_timet solver_start=current_time();
     decision_proceduret::resultt res=supert::dec_solve();
+    time_periodt solver=current_time()-solver_start;
 
-    switch(res)
+    if(res!=resultt::D_SATISFIABLE)
     {
-    case D_SATISFIABLE:
-      if(!check_axioms())
-      {
-        debug() << "check_SAT: got SAT but the model is not correct" << eom;
-      }
-      else
-      {
-        debug() << "check_SAT: the model is correct" << eom;
-        return D_SATISFIABLE;
-      }
+      report_iteration(solver, time_periodt(), time_periodt());
+      return res;
+    }
 
-      debug() <<  "refining..." << eom;
-      // Since the model is not correct although we got SAT, we need to refine
-      // the property we are checking by adding more indices to the index set,
-      // and instantiating universal formulas with this indices.
-      // We will then relaunch the solver with these added lemmas.
-      current_index_set.clear();
-      update_index_set(cur);
-      cur.clear();
-      add_instantiations();
-
-      if(current_index_set.empty())
-      {
-        debug() << "current index set is empty" << eom;
-        return D_SATISFIABLE;
-      }
+    absolute_timet check_start=current_time();
+    const bool model_is_correct=check_axioms();
+    time_periodt check=current_time()-check_start;
 
-      display_index_set();
-      debug()<< "instantiating NOT_CONTAINS constraints" << eom;
-      for(unsigned i=0; i<not_contains_axioms.size(); i++)
-      {
-        debug()<< "constraint " << i << eom;
-        std::list<exprt> lemmas;
-        instantiate_not_contains(not_contains_axioms[i], lemmas);
-        for(const exprt &lemma : lemmas)
-          add_lemma(lemma);
-      }
-      break;
-    default:
-      return res;
+    if(model_is_correct)
+    {
+      debug() << "check_SAT: the model is correct" << eom;
+      report_iteration(solver, check, time_periodt());
+      return resultt::D_SATISFIABLE;
+    }
+
+    debug() << "check_SAT: got SAT but the model is not correct" << eom;
+    debug() <<  "refining..." << eom;
+
+    // Since the model is not correct although we got SAT, we need to refine
+    // the property we are checking by adding more indices to the index set,
+    // and instantiating universal formulas with this indices.
+    // Only the new indices are instantiated, the others have been before.
+    // We will then relaunch the solver with these added lemmas.
+    absolute_timet instantiation_start=current_time();
+    current_index_set.clear();
+    update_index_set(cur);
+    cur.clear();
+    add_instantiations();
+
+    if(current_index_set.empty())
+    {
+      debug() << "current index set is empty" << eom;
+      report_iteration(
+        solver, check, current_time()-instantiation_start);
+      return resultt::D_SATISFIABLE;
     }
+
+    display_index_set();
+    instantiate_not_contains();
+
+    report_iteration(
+      solver, check, current_time()-instantiation_start);
   }
   debug() << "string_refinementt::dec_solve reached the maximum number"
            << "of steps allowed" << eom;
-  return D_ERROR;
+  return resultt::D_ERROR;
 }
 
 /// fills as many 0 as necessary in the bit vectors to have the right width
@@ -440,9 +517,17 @@ bool string_refinementt::check_axioms()
   // Maps from indexes of violated universal axiom to a witness of violation
   std::map<size_t, exprt> violated;
 
+  // Without counter examples, a single violation decides the result, and
+  // the not_contains axioms are always taken as violated (see below).
+  const bool stop_at_violation=!use_counter_example;
+
   debug() << "there are " << universal_axioms.size()
           << " universal axioms" << eom;
-  for(size_t i=0; i<universal_axioms.size(); i++)
+  for(size_t i=0;
+      i<universal_axioms.size() &&
+      !(stop_at_violation &&
+        (!violated.empty() || !not_contains_axioms.empty()));
+      i++)
   {
     const string_constraintt &axiom=universal_axioms[i];
 
@@ -457,13 +542,13 @@ bool string_refinementt::check_axioms()
 
     switch(solver())
     {
-    case decision_proceduret::D_SATISFIABLE:
+    case decision_proceduret::resultt::D_SATISFIABLE:
       {
         exprt val=solver.get(axiom.univ_var());
         violated[i]=val;
       }
       break;
-    case decision_proceduret::D_UNSATISFIABLE:
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
       break;
     default:
       throw "failure in checking axiom";
@@ -792,55 +877,17 @@ void string_refinementt::update_index_set(const exprt &formula)
   }
 }
 
-
-// Will be used to visit an expression and return the index used
-// with the given char array
-class find_index_visitort: public const_expr_visitort
-{
-private:
-  const exprt &str_;
-
-public:
-  explicit find_index_visitort(const exprt &str): str_(str) {}
-
-  void operator()(const exprt &expr)
-  {
-    if(expr.id()==ID_index)
-    {
-      const index_exprt &i=to_index_expr(expr);
-      if(i.array()==str_)
-        throw i.index();
-    }
-  }
-};
-
-/// find an index used in the expression for str, for instance with arguments
-/// (str[k] == 'a') and str, the function should return k
-/// \par parameters: a formula expr and a char array str
-/// \return an index expression
-exprt find_index(const exprt &expr, const exprt &str)
-{
-  find_index_visitort v1(str);
-  try
-  {
-    expr.visit(v1);
-    return nil_exprt();
-  }
-  catch (exprt i) { return i; }
-}
-
-
-/// \par parameters: an universaly quantified formula `axiom`, an array of char
-/// variable `str`, and an index expression `val`.
+/// \par parameters: an universaly quantified formula `axiom`, the index `idx`
+/// used in `axiom` for an array of char variable `str` (see find_index), and
+/// an index expression `val`.
 /// \return substitute `qvar` the universaly quantified variable of `axiom`, by
 ///   an index `val`, in `axiom`, so that the index used for `str` equals `val`.
 ///   For instance, if `axiom` corresponds to $\forall q. s[q+x]='a' &&
-///   t[q]='b'$, `instantiate(axom,s,v)` would return an expression for
+///   t[q]='b'$, `instantiate(axom,q+x,v)` would return an expression for
 ///   $s[v]='a' && t[v-x]='b'$.
 exprt string_refinementt::instantiate(
-  const string_constraintt &axiom, const exprt &str, const exprt &val)
+  const string_constraintt &axiom, const exprt &idx, const exprt &val)
 {
-  exprt idx=find_index(axiom.body(), str);
   if(idx.is_nil())
     return true_exprt();
   if(!find_qvar(idx, axiom.univ_var()))
@@ -859,53 +906,83 @@ exprt string_refinementt::instantiate(
 }
 
 
+/// instantiate `axiom` with the pairs of indices of its two strings of which
+/// at least one is in the current index set; the other pairs have been
+/// instantiated before
 void string_refinementt::instantiate_not_contains(
   const string_not_contains_constraintt &axiom, std::list<exprt> &new_lemmas)
 {
-  exprt s0=axiom.s0();
-  exprt s1=axiom.s1();
+  const exprt &s0=axiom.s0();
+  const exprt &s1=axiom.s1();
 
   debug() << "instantiate not contains " << from_expr(s0) << " : "
           << from_expr(s1) << eom;
-  expr_sett index_set0=index_set[to_string_expr(s0).content()];
-  expr_sett index_set1=index_set[to_string_expr(s1).content()];
+  const exprt &content0=to_string_expr(s0).content();
+  const exprt &content1=to_string_expr(s1).content();
+  const expr_sett &index_set0=index_set[content0];
+  const expr_sett &index_set1=index_set[content1];
+
+  const auto current0=current_index_set.find(content0);
+  const auto current1=current_index_set.find(content1);
 
-  for(auto it0 : index_set0)
-    for(auto it1 : index_set1)
+  for(const auto &it0 : index_set0)
+  {
+    const bool is_new0=
+      current0!=current_index_set.end() && current0->second.count(it0)!=0;
+
+    for(const auto &it1 : index_set1)
     {
-      debug() << from_expr(it0) << " : " << from_expr(it1) << eom;
-      exprt val=minus_exprt(it0, it1);
-      exprt witness=generator.get_witness_of(axiom, val);
-      and_exprt prem_and_is_witness(
-        axiom.premise(),
-        equal_exprt(witness, it1));
-
-      not_exprt differ(
-        equal_exprt(
-          to_string_expr(s0)[it0],
-          to_string_expr(s1)[it1]));
-      exprt lemma=implies_exprt(prem_and_is_witness, differ);
-
-      new_lemmas.push_back(lemma);
-      // we put bounds on the witnesses:
-      // 0 <= v <= |s0| - |s1| ==> 0 <= v+w[v] < |s0| && 0 <= w[v] < |s1|
-      exprt zero=from_integer(0, val.type());
-      binary_relation_exprt c1(zero, ID_le, plus_exprt(val, witness));
-      binary_relation_exprt c2
-        (to_string_expr(s0).length(), ID_gt, plus_exprt(val, witness));
-      binary_relation_exprt c3(to_string_expr(s1).length(), ID_gt, witness);
-      binary_relation_exprt c4(zero, ID_le, witness);
-
-      minus_exprt diff(
-        to_string_expr(s0).length(),
-        to_string_expr(s1).length());
-
-      and_exprt premise(
-        binary_relation_exprt(zero, ID_le, val),
-        binary_relation_exprt(diff, ID_ge, val));
-      exprt witness_bounds=implies_exprt(
-        premise,
-        and_exprt(and_exprt(c1, c2), and_exprt(c3, c4)));
-      new_lemmas.push_back(witness_bounds);
+      if(is_new0 ||
+         (current1!=current_index_set.end() &&
+          current1->second.count(it1)!=0))
+        instantiate_not_contains(axiom, it0, it1, new_lemmas);
     }
+  }
+}
+
+/// instantiate `axiom` with the index `it0` of its first string and the index
+/// `it1` of its second string
+void string_refinementt::instantiate_not_contains(
+  const string_not_contains_constraintt &axiom,
+  const exprt &it0,
+  const exprt &it1,
+  std::list<exprt> &new_lemmas)
+{
+  const exprt &s0=axiom.s0();
+  const exprt &s1=axiom.s1();
+
+  debug() << from_expr(it0) << " : " << from_expr(it1) << eom;
+  exprt val=minus_exprt(it0, it1);
+  exprt witness=generator.get_witness_of(axiom, val);
+  and_exprt prem_and_is_witness(
+    axiom.premise(),
+    equal_exprt(witness, it1));
+
+  not_exprt differ(
+    equal_exprt(
+      to_string_expr(s0)[it0],
+      to_string_expr(s1)[it1]));
+  exprt lemma=implies_exprt(prem_and_is_witness, differ);
+
+  new_lemmas.push_back(lemma);
+  // we put bounds on the witnesses:
+  // 0 <= v <= |s0| - |s1| ==> 0 <= v+w[v] < |s0| && 0 <= w[v] < |s1|
+  exprt zero=from_integer(0, val.type());
+  binary_relation_exprt c1(zero, ID_le, plus_exprt(val, witness));
+  binary_relation_exprt c2
+    (to_string_expr(s0).length(), ID_gt, plus_exprt(val, witness));
+  binary_relation_exprt c3(to_string_expr(s1).length(), ID_gt, witness);
+  binary_relation_exprt c4(zero, ID_le, witness);
+
+  minus_exprt diff(
+    to_string_expr(s0).length(),
+    to_string_expr(s1).length());
+
+  and_exprt premise(
+    binary_relation_exprt(zero, ID_le, val),
+    binary_relation_exprt(diff, ID_ge, val));
+  exprt witness_bounds=implies_exprt(
+    premise,
+    and_exprt(and_exprt(c1, c2), and_exprt(c3, c4)));
+  new_lemmas.push_back(witness_bounds);
 }
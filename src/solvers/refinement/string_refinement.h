@@ -21,6 +21,7 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 #define CPROVER_SOLVERS_REFINEMENT_STRING_REFINEMENT_H
 
 #include <util/string_expr.h>
+#include <util/time_stopping.h>
 #include <solvers/refinement/string_constraint.h>
 #include <solvers/refinement/string_constraint_generator.h>
 
@@ -84,6 +85,13 @@ private:
   std::map<exprt, expr_sett> current_index_set;
   std::map<exprt, expr_sett> index_set;
 
+  // number of calls to the solver in the refinement loop
+  unsigned iterations;
+  void report_iteration(
+    const time_periodt &solver,
+    const time_periodt &check,
+    const time_periodt &instantiation);
+
   void display_index_set();
 
   void add_lemma(const exprt &lemma, bool add_to_index_set=true);
@@ -102,10 +110,16 @@ private:
   void initial_index_set(const std::vector<string_constraintt> &string_axioms);
 
   exprt instantiate(
-    const string_constraintt &axiom, const exprt &str, const exprt &val);
+    const string_constraintt &axiom, const exprt &idx, const exprt &val);
 
+  void instantiate_not_contains();
+  void instantiate_not_contains(
+    const string_not_contains_constraintt &axiom,
+    std::list<exprt> &new_lemmas);
   void instantiate_not_contains(
     const string_not_contains_constraintt &axiom,
+    const exprt &index0,
+    const exprt &index1,
     std::list<exprt> &new_lemmas);
 
   exprt compute_inverse_function(
@@ -12,7 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_PARSER_H
 #define CPROVER_UTIL_PARSER_H
 
-#include <iosfwd>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -46,8 +46,18 @@ public:
 
   bool read(char &ch)
   {
-    if(!in->read(&ch, 1))
+    // Go to the stream buffer directly, as istream::read would
+    // construct a sentry for every single character.
+    const std::streambuf::int_type c=in->rdbuf()->sbumpc();
+
+    if(std::streambuf::traits_type::eq_int_type(
+         c, std::streambuf::traits_type::eof()))
+    {
+      in->setstate(std::ios::eofbit | std::ios::failbit);
       return false;
+    }
+
+    ch=std::streambuf::traits_type::to_char_type(c);
 
     if(ch=='\n')
     {
@@ -53,6 +53,11 @@ public:
     rename(dest);
   }
 
+  bool empty() const
+  {
+    return expr_map.empty() && type_map.empty();
+  }
+
   rename_symbolt();
   virtual ~rename_symbolt();
 
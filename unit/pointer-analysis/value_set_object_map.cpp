@@ -0,0 +1,156 @@
+/*******************************************************************\
+
+ Module: Unit tests for value_sett::object_map_dt
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for value_sett::object_map_dt
+
+#include <catch.hpp>
+
+#include <vector>
+
+#include <pointer-analysis/value_set.h>
+
+typedef value_sett::object_map_dt object_map_dt;
+
+static std::vector<unsigned> keys(const object_map_dt &map)
+{
+  std::vector<unsigned> result;
+
+  for(object_map_dt::const_iterator it=map.begin(); it!=map.end(); it++)
+    result.push_back(it->first);
+
+  return result;
+}
+
+SCENARIO("value_set_object_map",
+  "[core][pointer-analysis][value_set][object_map]")
+{
+  GIVEN("A map with entries inserted in order and out of order")
+  {
+    object_map_dt map;
+
+    // 0, 2, ..., 98 are appended to the sorted entries, the odd numbers
+    // are inserted out of order, more than are merged in one go
+    for(unsigned i=0; i<100; i+=2)
+      map[i]=value_sett::objectt(i);
+    for(unsigned i=99; i<100; i-=2)
+      map[i]=value_sett::objectt(i);
+
+    THEN("It holds every entry once")
+    {
+      REQUIRE(map.size()==100);
+      REQUIRE_FALSE(map.empty());
+    }
+
+    THEN("Iteration is by object number")
+    {
+      std::vector<unsigned> expected;
+      for(unsigned i=0; i<100; i++)
+        expected.push_back(i);
+
+      REQUIRE(keys(map)==expected);
+    }
+
+    THEN("Every entry is found with its offset")
+    {
+      for(unsigned i=0; i<100; i++)
+      {
+        object_map_dt::const_iterator it=map.find(i);
+        REQUIRE(it!=map.end());
+        REQUIRE(it->first==i);
+        REQUIRE(it->second.offset==i);
+
+        const value_sett::objectt *object=map.get(i);
+        REQUIRE(object!=nullptr);
+        REQUIRE(object->offset==i);
+      }
+
+      REQUIRE(map.find(100)==map.end());
+      REQUIRE(map.get(100)==nullptr);
+    }
+
+    THEN("Iteration continues from an entry that was found")
+    {
+      object_map_dt::const_iterator it=map.find(41);
+      REQUIRE(it!=map.end());
+      ++it;
+      REQUIRE(it->first==42);
+      ++it;
+      REQUIRE(it->first==43);
+    }
+
+    THEN("Inserting an existing entry returns it")
+    {
+      map[7].offset=70;
+      REQUIRE(map.size()==100);
+      REQUIRE(map.get(7)->offset==70);
+    }
+
+    WHEN("Entries are erased")
+    {
+      REQUIRE(map.erase(10)==1);
+      REQUIRE(map.erase(11)==1);
+      REQUIRE(map.erase(11)==0);
+      REQUIRE(map.erase(100)==0);
+
+      THEN("They are gone, and the others are still there in order")
+      {
+        REQUIRE(map.size()==98);
+        REQUIRE(map.find(10)==map.end());
+        REQUIRE(map.find(11)==map.end());
+
+        std::vector<unsigned> expected;
+        for(unsigned i=0; i<100; i++)
+          if(i!=10 && i!=11)
+            expected.push_back(i);
+
+        REQUIRE(keys(map)==expected);
+      }
+    }
+  }
+
+  GIVEN("A map with pending entries that is read")
+  {
+    object_map_dt map;
+    map[10];
+    map[20];
+    map[5];
+    map[15];
+
+    const object_map_dt &const_map=map;
+
+    THEN("Lookups during iteration keep the iterator valid")
+    {
+      std::vector<unsigned> visited;
+
+      for(object_map_dt::const_iterator it=const_map.begin();
+          it!=const_map.end();
+          it++)
+      {
+        REQUIRE(const_map.find(it->first)==it);
+        REQUIRE(const_map.find(15)!=const_map.end());
+        REQUIRE(const_map.get(5)!=nullptr);
+        visited.push_back(it->first);
+      }
+
+      REQUIRE(visited==std::vector<unsigned>({5, 10, 15, 20}));
+    }
+
+    THEN("A copy is equal entry by entry")
+    {
+      object_map_dt copy(map);
+      REQUIRE(keys(copy)==keys(map));
+    }
+
+    THEN("Appending merges the pending entries")
+    {
+      map.push_back(object_map_dt::value_type(30, value_sett::objectt()));
+      REQUIRE(keys(map)==std::vector<unsigned>({5, 10, 15, 20, 30}));
+    }
+  }
+}